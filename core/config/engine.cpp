@@ -66,6 +66,30 @@ double Engine::get_physics_jitter_fix() const {
 	return physics_jitter_fix;
 }
 
+void Engine::set_deterministic_physics_steps(int p_steps) {
+	ERR_FAIL_COND_MSG(p_steps < 0, "Deterministic physics steps per frame must be 0 (disabled) or greater.");
+	deterministic_physics_steps = p_steps;
+}
+
+int Engine::get_deterministic_physics_steps() const {
+	return deterministic_physics_steps;
+}
+
+void Engine::set_external_physics_clock(bool p_enabled) {
+	external_physics_clock = p_enabled;
+	_external_physics_ticks = 0;
+}
+
+bool Engine::is_external_physics_clock() const {
+	return external_physics_clock;
+}
+
+void Engine::advance_physics_clock(int p_ticks) {
+	ERR_FAIL_COND_MSG(!external_physics_clock, "The physics clock can only be advanced manually when using an external physics clock.");
+	ERR_FAIL_COND_MSG(p_ticks < 0, "The physics clock can't be advanced by a negative number of ticks.");
+	_external_physics_ticks += p_ticks;
+}
+
 void Engine::set_max_fps(int p_fps) {
 	_max_fps = p_fps > 0 ? p_fps : 0;
 }
@@ -65,6 +65,9 @@ private:
 	double _time_scale = 1.0;
 	uint64_t _physics_frames = 0;
 	int max_physics_steps_per_frame = 8;
+	int deterministic_physics_steps = 0;
+	bool external_physics_clock = false;
+	uint32_t _external_physics_ticks = 0;
 	double _physics_interpolation_fraction = 0.0f;
 	bool abort_on_gpu_errors = false;
 	bool use_validation_layers = false;
@@ -97,6 +100,13 @@ public:
 	void set_physics_jitter_fix(double p_threshold);
 	double get_physics_jitter_fix() const;
 
+	void set_deterministic_physics_steps(int p_steps);
+	int get_deterministic_physics_steps() const;
+
+	void set_external_physics_clock(bool p_enabled);
+	bool is_external_physics_clock() const;
+	void advance_physics_clock(int p_ticks);
+
 	virtual void set_max_fps(int p_fps);
 	virtual int get_max_fps() const;
 
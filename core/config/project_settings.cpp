@@ -469,6 +469,10 @@ bool ProjectSettings::_load_resource_pack(const String &p_pack, bool p_replace_f
 		return false;
 	}
 
+	if (!boot_image_path.is_empty()) {
+		boot_image_pack_key += "|" + _get_file_stamp(p_pack);
+	}
+
 	//if data.pck is found, all directory access will be from here
 	DirAccess::make_default<DirAccessPack>(DirAccess::ACCESS_RESOURCES);
 	using_datapack = true;
@@ -714,6 +718,14 @@ Error ProjectSettings::_load_settings_binary(const String &p_path) {
 		err = decode_variant(value, d.ptr(), d.size(), nullptr, true);
 		ERR_CONTINUE_MSG(err != OK, "Error decoding property: " + key + ".");
 		set(key, value);
+		if (boot_image_capturing) {
+			boot_image_settings.push_back(Pair<String, Variant>(key, value));
+		}
+	}
+
+	if (boot_image_capturing) {
+		boot_image_from_text = false;
+		boot_image_config_version = CONFIG_VERSION;
 	}
 
 	return OK;
@@ -752,6 +764,11 @@ Error ProjectSettings::_load_settings_text(const String &p_path) {
 			// ProjectSettings conversions if need be.
 			_convert_to_last_version(config_version);
 			last_save_time = FileAccess::get_modified_time(get_resource_path().path_join("project.godot"));
+			if (boot_image_capturing) {
+				// Values are captured as written, the conversion is applied again when the image is loaded.
+				boot_image_from_text = true;
+				boot_image_config_version = config_version;
+			}
 			return OK;
 		}
 		ERR_FAIL_COND_V_MSG(err != OK, err, "Error parsing " + p_path + " at line " + itos(lines) + ": " + error_text + " File might be corrupted.");
@@ -761,10 +778,10 @@ Error ProjectSettings::_load_settings_text(const String &p_path) {
 				config_version = value;
 				ERR_FAIL_COND_V_MSG(config_version > CONFIG_VERSION, ERR_FILE_CANT_OPEN, vformat("Can't open project at '%s', its `config_version` (%d) is from a more recent and incompatible version of the engine. Expected config version: %d.", p_path, config_version, CONFIG_VERSION));
 			} else {
-				if (section.is_empty()) {
-					set(assign, value);
-				} else {
-					set(section + "/" + assign, value);
+				String key = section.is_empty() ? assign : section + "/" + assign;
+				set(key, value);
+				if (boot_image_capturing) {
+					boot_image_settings.push_back(Pair<String, Variant>(key, value));
 				}
 			}
 		} else if (!next_tag.name.is_empty()) {
@@ -773,10 +790,108 @@ Error ProjectSettings::_load_settings_text(const String &p_path) {
 	}
 }
 
+String ProjectSettings::_get_file_stamp(const String &p_path) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	if (f.is_null()) {
+		return String();
+	}
+	return itos(f->get_length()) + ":" + itos(FileAccess::get_modified_time(p_path));
+}
+
+String ProjectSettings::_get_boot_image_key(const String &p_text_path, const String &p_bin_path) const {
+	// Size and modification time only, hashing the files would cost as much as parsing them.
+	String source_stamp = _get_file_stamp(p_bin_path);
+	if (source_stamp.is_empty()) {
+		source_stamp = _get_file_stamp(p_text_path);
+	}
+	if (source_stamp.is_empty()) {
+		// No project file here.
+		return String();
+	}
+
+	String key = resource_path + "|" + source_stamp + boot_image_pack_key;
+	key += "|" + _get_file_stamp(p_text_path.get_base_dir().path_join("override.cfg"));
+	key += "|" + _get_file_stamp(OS::get_singleton()->get_executable_path().get_base_dir().path_join("override.cfg"));
+	return key;
+}
+
+Error ProjectSettings::_load_boot_image() {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(boot_image_path, FileAccess::READ, &err);
+	if (err != OK) {
+		return err;
+	}
+
+	uint8_t hdr[4];
+	f->get_buffer(hdr, 4);
+	ERR_FAIL_COND_V_MSG((hdr[0] != 'G' || hdr[1] != 'D' || hdr[2] != 'B' || hdr[3] != 'I'), ERR_FILE_CORRUPT, "Corrupted header in boot image (not GDBI).");
+
+	// Any mismatch means the image is stale, it will be regenerated once the project is loaded.
+	if (f->get_32() != BOOT_IMAGE_VERSION || f->get_pascal_string() != VERSION_FULL_BUILD || f->get_pascal_string() != boot_image_key) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	bool from_text = f->get_8();
+	int config_version = f->get_32();
+	boot_image_settings.clear();
+	uint32_t count = f->get_32();
+
+	for (uint32_t i = 0; i < count; i++) {
+		String key = f->get_pascal_string();
+
+		uint32_t vlen = f->get_32();
+		Vector<uint8_t> d;
+		d.resize(vlen);
+		f->get_buffer(d.ptrw(), vlen);
+		Variant value;
+		err = decode_variant(value, d.ptr(), d.size(), nullptr, true);
+		ERR_CONTINUE_MSG(err != OK, "Error decoding property: " + key + ".");
+		set(key, value);
+		boot_image_settings.push_back(Pair<String, Variant>(key, value));
+	}
+
+	// Same as at the end of _load_settings_text().
+	_convert_to_last_version(config_version);
+	if (from_text) {
+		last_save_time = FileAccess::get_modified_time(get_resource_path().path_join("project.godot"));
+	}
+	boot_image_from_text = from_text;
+	boot_image_config_version = config_version;
+
+	boot_image_class_list_md5 = f->get_pascal_string();
+	uint32_t vlen = f->get_32();
+	Vector<uint8_t> d;
+	d.resize(vlen);
+	f->get_buffer(d.ptrw(), vlen);
+	Variant class_list;
+	if (decode_variant(class_list, d.ptr(), d.size(), nullptr, true) == OK) {
+		boot_image_class_list = class_list;
+	}
+
+	boot_image_loaded = true;
+	return OK;
+}
+
 Error ProjectSettings::_load_settings_text_or_binary(const String &p_text_path, const String &p_bin_path) {
+	if (!boot_image_path.is_empty()) {
+		boot_image_key = _get_boot_image_key(p_text_path, p_bin_path);
+		if (!boot_image_key.is_empty()) {
+			if (_load_boot_image() == OK) {
+				return OK;
+			}
+			boot_image_dirty = true;
+		}
+	}
+
+	// Only values read from the project file go into the boot image, not the
+	// GLOBAL_DEF defaults nor the overrides loaded after it.
+	boot_image_settings.clear();
+	boot_image_capturing = !boot_image_key.is_empty();
+
 	// Attempt first to load the binary project.godot file.
 	Error err = _load_settings_binary(p_bin_path);
 	if (err == OK) {
+		boot_image_capturing = false;
 		return OK;
 	} else if (err != ERR_FILE_NOT_FOUND) {
 		// If the file exists but can't be loaded, we want to know it.
@@ -784,7 +899,9 @@ Error ProjectSettings::_load_settings_text_or_binary(const String &p_text_path,
 	}
 
 	// Fallback to text-based project.godot file if binary was not found.
+	boot_image_settings.clear();
 	err = _load_settings_text(p_text_path);
+	boot_image_capturing = false;
 	if (err == OK) {
 		return OK;
 	} else if (err != ERR_FILE_NOT_FOUND) {
@@ -1181,6 +1298,15 @@ TypedArray<Dictionary> ProjectSettings::get_global_class_list() {
 		return global_class_list;
 	}
 
+	if (boot_image_loaded) {
+		if (FileAccess::get_md5(get_global_class_list_path()) == boot_image_class_list_md5) {
+			global_class_list = boot_image_class_list;
+			is_global_class_list_loaded = true;
+			return global_class_list;
+		}
+		boot_image_dirty = true;
+	}
+
 	Ref<ConfigFile> cf;
 	cf.instantiate();
 	if (cf->load(get_global_class_list_path()) == OK) {
@@ -1210,6 +1336,68 @@ void ProjectSettings::store_global_class_list(const Array &p_classes) {
 	cf->save(get_global_class_list_path());
 
 	global_class_list = p_classes;
+	if (!boot_image_path.is_empty()) {
+		boot_image_dirty = true;
+	}
+}
+
+void ProjectSettings::set_boot_image_path(const String &p_path) {
+	boot_image_path = p_path;
+}
+
+String ProjectSettings::get_boot_image_path() const {
+	return boot_image_path;
+}
+
+Error ProjectSettings::save_boot_image() {
+	ERR_FAIL_COND_V_MSG(boot_image_path.is_empty(), ERR_UNCONFIGURED, "No boot image path was set.");
+	if (!boot_image_dirty) {
+		return OK;
+	}
+
+	if (boot_image_key.is_empty()) {
+		// The settings didn't come from a project file, nothing to snapshot.
+		return OK;
+	}
+
+	const Array class_list = get_global_class_list();
+
+	Error err;
+	Ref<FileAccess> file = FileAccess::open(boot_image_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Couldn't save boot image at " + boot_image_path + ".");
+
+	uint8_t hdr[4] = { 'G', 'D', 'B', 'I' };
+	file->store_buffer(hdr, 4);
+	file->store_32(BOOT_IMAGE_VERSION);
+	file->store_pascal_string(VERSION_FULL_BUILD);
+	file->store_pascal_string(boot_image_key);
+	file->store_8(boot_image_from_text);
+	file->store_32(boot_image_config_version);
+
+	file->store_32(boot_image_settings.size());
+	for (const Pair<String, Variant> &E : boot_image_settings) {
+		file->store_pascal_string(E.first);
+		int len;
+		err = encode_variant(E.second, nullptr, len, true);
+		ERR_FAIL_COND_V_MSG(err != OK, ERR_INVALID_DATA, "Error when trying to encode Variant for boot image.");
+		Vector<uint8_t> buff;
+		buff.resize(len);
+		encode_variant(E.second, buff.ptrw(), len, true);
+		file->store_32(len);
+		file->store_buffer(buff.ptr(), buff.size());
+	}
+
+	file->store_pascal_string(FileAccess::get_md5(get_global_class_list_path()));
+	int len;
+	encode_variant(class_list, nullptr, len, true);
+	Vector<uint8_t> buff;
+	buff.resize(len);
+	encode_variant(class_list, buff.ptrw(), len, true);
+	file->store_32(len);
+	file->store_buffer(buff.ptr(), buff.size());
+
+	boot_image_dirty = false;
+	return OK;
 }
 
 bool ProjectSettings::has_custom_feature(const String &p_feature) const {
@@ -110,6 +110,20 @@ protected:
 	Array global_class_list;
 	bool is_global_class_list_loaded = false;
 
+	// Boot image, a binary snapshot of the loaded settings and global class list
+	// used to skip parsing project.godot and the global class cache on startup.
+	String boot_image_path;
+	String boot_image_key;
+	String boot_image_pack_key; // Stamps of the loaded packs, files inside them have no modification time.
+	bool boot_image_loaded = false;
+	bool boot_image_dirty = false;
+	bool boot_image_capturing = false;
+	bool boot_image_from_text = false;
+	int boot_image_config_version = 0;
+	List<Pair<String, Variant>> boot_image_settings; // Settings from the project file only, overrides are applied on top.
+	Array boot_image_class_list;
+	String boot_image_class_list_md5;
+
 	String project_data_dir_name;
 
 	bool _set(const StringName &p_name, const Variant &p_value);
@@ -126,6 +140,9 @@ protected:
 	Error _load_settings_text(const String &p_path);
 	Error _load_settings_binary(const String &p_path);
 	Error _load_settings_text_or_binary(const String &p_text_path, const String &p_bin_path);
+	static String _get_file_stamp(const String &p_path);
+	String _get_boot_image_key(const String &p_text_path, const String &p_bin_path) const;
+	Error _load_boot_image();
 
 	Error _save_settings_text(const String &p_file, const RBMap<String, List<String>> &props, const CustomMap &p_custom = CustomMap(), const String &p_custom_features = String());
 	Error _save_settings_binary(const String &p_file, const RBMap<String, List<String>> &props, const CustomMap &p_custom = CustomMap(), const String &p_custom_features = String());
@@ -152,6 +169,7 @@ protected:
 
 public:
 	static const int CONFIG_VERSION = 5;
+	static const int BOOT_IMAGE_VERSION = 3;
 
 	void set_setting(const String &p_setting, const Variant &p_value);
 	Variant get_setting(const String &p_setting, const Variant &p_default_value = Variant()) const;
@@ -159,6 +177,10 @@ public:
 	void store_global_class_list(const Array &p_classes);
 	String get_global_class_list_path() const;
 
+	void set_boot_image_path(const String &p_path);
+	String get_boot_image_path() const;
+	Error save_boot_image();
+
 	bool has_setting(String p_var) const;
 	String localize_path(const String &p_path) const;
 	String globalize_path(const String &p_path) const;
@@ -1578,6 +1578,26 @@ double Engine::get_physics_interpolation_fraction() const {
 	return ::Engine::get_singleton()->get_physics_interpolation_fraction();
 }
 
+void Engine::set_deterministic_physics_steps(int p_steps) {
+	::Engine::get_singleton()->set_deterministic_physics_steps(p_steps);
+}
+
+int Engine::get_deterministic_physics_steps() const {
+	return ::Engine::get_singleton()->get_deterministic_physics_steps();
+}
+
+void Engine::set_external_physics_clock(bool p_enabled) {
+	::Engine::get_singleton()->set_external_physics_clock(p_enabled);
+}
+
+bool Engine::is_external_physics_clock() const {
+	return ::Engine::get_singleton()->is_external_physics_clock();
+}
+
+void Engine::advance_physics_clock(int p_ticks) {
+	::Engine::get_singleton()->advance_physics_clock(p_ticks);
+}
+
 void Engine::set_max_fps(int p_fps) {
 	::Engine::get_singleton()->set_max_fps(p_fps);
 }
@@ -1726,6 +1746,11 @@ void Engine::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_physics_jitter_fix", "physics_jitter_fix"), &Engine::set_physics_jitter_fix);
 	ClassDB::bind_method(D_METHOD("get_physics_jitter_fix"), &Engine::get_physics_jitter_fix);
 	ClassDB::bind_method(D_METHOD("get_physics_interpolation_fraction"), &Engine::get_physics_interpolation_fraction);
+	ClassDB::bind_method(D_METHOD("set_deterministic_physics_steps", "steps"), &Engine::set_deterministic_physics_steps);
+	ClassDB::bind_method(D_METHOD("get_deterministic_physics_steps"), &Engine::get_deterministic_physics_steps);
+	ClassDB::bind_method(D_METHOD("set_external_physics_clock", "enabled"), &Engine::set_external_physics_clock);
+	ClassDB::bind_method(D_METHOD("is_external_physics_clock"), &Engine::is_external_physics_clock);
+	ClassDB::bind_method(D_METHOD("advance_physics_clock", "ticks"), &Engine::advance_physics_clock);
 	ClassDB::bind_method(D_METHOD("set_max_fps", "max_fps"), &Engine::set_max_fps);
 	ClassDB::bind_method(D_METHOD("get_max_fps"), &Engine::get_max_fps);
 
@@ -1775,6 +1800,8 @@ void Engine::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_fps"), "set_max_fps", "get_max_fps");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "time_scale"), "set_time_scale", "get_time_scale");
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "physics_jitter_fix"), "set_physics_jitter_fix", "get_physics_jitter_fix");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "deterministic_physics_steps"), "set_deterministic_physics_steps", "get_deterministic_physics_steps");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "external_physics_clock"), "set_external_physics_clock", "is_external_physics_clock");
 }
 
 Engine *Engine::singleton = nullptr;
@@ -481,6 +481,13 @@ public:
 	double get_physics_jitter_fix() const;
 	double get_physics_interpolation_fraction() const;
 
+	void set_deterministic_physics_steps(int p_steps);
+	int get_deterministic_physics_steps() const;
+
+	void set_external_physics_clock(bool p_enabled);
+	bool is_external_physics_clock() const;
+	void advance_physics_clock(int p_ticks);
+
 	void set_max_fps(int p_fps);
 	int get_max_fps() const;
 
@@ -0,0 +1,195 @@
+/**************************************************************************/
+/*  trace_profiler.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "trace_profiler.h"
+
+#include "core/io/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+
+std::atomic_bool TraceProfiler::capturing = { false };
+SafeNumeric<uint32_t> TraceProfiler::generation;
+uint32_t TraceProfiler::events_per_thread = TraceProfiler::DEFAULT_EVENTS_PER_THREAD;
+uint64_t TraceProfiler::capture_begin_usec = 0;
+thread_local TraceProfiler::ThreadBufferOwner TraceProfiler::thread_buffer;
+Mutex TraceProfiler::buffers_mutex;
+LocalVector<TraceProfiler::ThreadBuffer *> TraceProfiler::buffers;
+
+TraceProfiler::ThreadBufferOwner::~ThreadBufferOwner() {
+	if (buffer) {
+		// Last access to the buffer from this thread, clear() may free it right after.
+		buffer->orphaned.store(true);
+	}
+}
+
+uint64_t TraceProfiler::get_ticks_usec() {
+	return OS::get_singleton()->get_ticks_usec();
+}
+
+TraceProfiler::ThreadBuffer *TraceProfiler::_register_thread_buffer() {
+	ThreadBuffer *tb = memnew(ThreadBuffer);
+	tb->thread_id = Thread::get_caller_id();
+
+	MutexLock lock(buffers_mutex);
+	buffers.push_back(tb);
+	thread_buffer.buffer = tb;
+	return tb;
+}
+
+void TraceProfiler::record(const char *p_name, const StringName &p_dynamic_name, uint64_t p_begin_usec) {
+	const uint64_t end_usec = get_ticks_usec();
+
+	ThreadBuffer *tb = thread_buffer.buffer;
+	if (unlikely(tb == nullptr)) {
+		tb = _register_thread_buffer();
+	}
+
+	// Pairs with end_capture(): either the flag is seen there, or the capture is seen as ended here.
+	tb->recording.store(true);
+	if (!capturing.load()) {
+		// The capture ended while the scope was open.
+		tb->recording.store(false);
+		return;
+	}
+
+	if (unlikely(tb->generation != generation.get())) {
+		// New capture, forget about the previous one.
+		tb->generation = generation.get();
+		tb->write_pos = 0;
+		if (tb->capacity != events_per_thread) {
+			if (tb->events) {
+				memdelete_arr(tb->events);
+			}
+			tb->events = memnew_arr(Event, events_per_thread);
+			tb->capacity = events_per_thread;
+		}
+	}
+
+	Event &e = tb->events[tb->write_pos % tb->capacity];
+	e.name = p_name;
+	e.dynamic_name = p_dynamic_name;
+	e.begin_usec = p_begin_usec;
+	e.end_usec = end_usec;
+	tb->write_pos++;
+
+	tb->recording.store(false, std::memory_order_release);
+}
+
+void TraceProfiler::begin_capture(uint32_t p_events_per_thread) {
+	ERR_FAIL_COND(p_events_per_thread == 0);
+
+	MutexLock lock(buffers_mutex);
+	ERR_FAIL_COND_MSG(capturing.load(), "A trace capture is already running.");
+
+	// Each thread resizes its own buffer when it records its first event of the capture.
+	events_per_thread = p_events_per_thread;
+	generation.increment();
+	capture_begin_usec = get_ticks_usec();
+	capturing.store(true);
+}
+
+void TraceProfiler::end_capture() {
+	MutexLock lock(buffers_mutex);
+	capturing.store(false);
+
+	// Any event started from now on sees the capture as ended, wait for the ones
+	// being written. This only takes a few stores, so spinning is fine.
+	for (ThreadBuffer *tb : buffers) {
+		while (tb->recording.load()) {
+		}
+	}
+}
+
+Error TraceProfiler::save_chrome_trace(const String &p_path) {
+	MutexLock lock(buffers_mutex);
+	ERR_FAIL_COND_V_MSG(capturing.load(), ERR_BUSY, "Can't save a trace while capturing, end the capture first.");
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Can't open trace file for writing: " + p_path + ".");
+
+	f->store_string("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+	const uint32_t current_generation = generation.get();
+	bool first = true;
+
+	for (ThreadBuffer *tb : buffers) {
+		if (tb->generation != current_generation) {
+			continue; // Thread did not record anything during the last capture.
+		}
+
+		const String tid = itos(tb->thread_id);
+		const String thread_name = tb->thread_id == Thread::get_main_id() ? "Main Thread" : "Thread " + tid;
+		f->store_string(String(first ? "" : ",\n") + "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" + tid + ",\"args\":{\"name\":\"" + thread_name + "\"}}");
+		first = false;
+
+		const uint64_t end = tb->write_pos;
+		const uint64_t begin = end > tb->capacity ? end - tb->capacity : 0;
+		for (uint64_t i = begin; i < end; i++) {
+			const Event &e = tb->events[i % tb->capacity];
+			const String name = e.name ? String(e.name) : String(e.dynamic_name).json_escape();
+			const uint64_t ts = e.begin_usec > capture_begin_usec ? e.begin_usec - capture_begin_usec : 0;
+			f->store_string(",\n{\"name\":\"" + name + "\",\"ph\":\"X\",\"pid\":0,\"tid\":" + tid + ",\"ts\":" + itos(ts) + ",\"dur\":" + itos(e.end_usec - e.begin_usec) + "}");
+		}
+	}
+
+	f->store_string("\n]}\n");
+	return OK;
+}
+
+void TraceProfiler::clear() {
+	MutexLock lock(buffers_mutex);
+	ERR_FAIL_COND_MSG(capturing.load(), "Can't clear trace buffers while capturing.");
+
+	// Threads that are still running keep their buffer, only the events are freed.
+	// The buffers of exited threads and of the calling thread are freed entirely.
+	uint32_t i = 0;
+	while (i < buffers.size()) {
+		ThreadBuffer *tb = buffers[i];
+		if (tb->events) {
+			memdelete_arr(tb->events);
+			tb->events = nullptr;
+			tb->capacity = 0;
+		}
+		tb->write_pos = 0;
+
+		if (tb == thread_buffer.buffer || tb->orphaned.load()) {
+			if (tb == thread_buffer.buffer) {
+				thread_buffer.buffer = nullptr;
+			}
+			memdelete(tb);
+			buffers.remove_at_unordered(i);
+		} else {
+			i++;
+		}
+	}
+}
@@ -0,0 +1,138 @@
+/**************************************************************************/
+/*  trace_profiler.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TRACE_PROFILER_H
+#define TRACE_PROFILER_H
+
+#include "core/os/mutex.h"
+#include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+#include <atomic>
+
+// Lightweight timeline profiler. Scoped markers are recorded in per-thread
+// ring buffers while a capture is running, and can be exported in the Chrome
+// trace event format (readable by chrome://tracing and Perfetto).
+// When no capture is running, a marker costs a single relaxed atomic load,
+// so markers are compiled in all builds.
+class TraceProfiler {
+public:
+	enum {
+		DEFAULT_EVENTS_PER_THREAD = 1 << 16,
+	};
+
+private:
+	struct Event {
+		const char *name = nullptr;
+		StringName dynamic_name; // Used if name is null, e.g. for script functions.
+		uint64_t begin_usec = 0;
+		uint64_t end_usec = 0;
+	};
+
+	// Written only by the thread that owns it, read by the collecting thread once
+	// the capture has ended and no event is being written.
+	struct ThreadBuffer {
+		uint64_t thread_id = 0;
+		uint32_t generation = 0;
+		uint32_t capacity = 0;
+		Event *events = nullptr;
+		uint64_t write_pos = 0;
+		// Set around each event write, so end_capture() can wait for the ones in flight.
+		std::atomic_bool recording = { false };
+		// Set when the thread exits, the buffer is then freed by the next clear().
+		std::atomic_bool orphaned = { false };
+	};
+
+	struct ThreadBufferOwner {
+		ThreadBuffer *buffer = nullptr;
+		~ThreadBufferOwner();
+	};
+
+	static std::atomic_bool capturing;
+	static SafeNumeric<uint32_t> generation;
+	static uint32_t events_per_thread;
+	static uint64_t capture_begin_usec;
+
+	static thread_local ThreadBufferOwner thread_buffer;
+
+	// Never locked when recording, except once per thread to register its buffer.
+	static Mutex buffers_mutex;
+	static LocalVector<ThreadBuffer *> buffers;
+
+	static ThreadBuffer *_register_thread_buffer();
+
+public:
+	_FORCE_INLINE_ static bool is_capturing() { return capturing.load(std::memory_order_acquire); }
+
+	static uint64_t get_ticks_usec();
+	static void record(const char *p_name, const StringName &p_dynamic_name, uint64_t p_begin_usec);
+
+	static void begin_capture(uint32_t p_events_per_thread = DEFAULT_EVENTS_PER_THREAD);
+	static void end_capture();
+	static Error save_chrome_trace(const String &p_path);
+	static void clear();
+
+	class Scope {
+		const char *name = nullptr;
+		StringName dynamic_name;
+		uint64_t begin_usec = 0;
+
+	public:
+		_FORCE_INLINE_ explicit Scope(const char *p_name) {
+			if (unlikely(is_capturing())) {
+				name = p_name;
+				begin_usec = get_ticks_usec();
+			}
+		}
+
+		_FORCE_INLINE_ explicit Scope(const StringName &p_name) {
+			if (unlikely(is_capturing())) {
+				dynamic_name = p_name;
+				begin_usec = get_ticks_usec();
+			}
+		}
+
+		_FORCE_INLINE_ ~Scope() {
+			if (unlikely(begin_usec != 0 && is_capturing())) {
+				record(name, dynamic_name, begin_usec);
+			}
+		}
+	};
+};
+
+#define TRACE_SCOPE_CONCAT_INTERNAL(m_a, m_b) m_a##m_b
+#define TRACE_SCOPE_CONCAT(m_a, m_b) TRACE_SCOPE_CONCAT_INTERNAL(m_a, m_b)
+
+// Records the time spent until the end of the current scope. The name must be
+// a string literal, or a StringName for names only known at run time.
+#define TRACE_SCOPE(m_name) TraceProfiler::Scope TRACE_SCOPE_CONCAT(_trace_scope_, __LINE__)(m_name)
+
+#endif // TRACE_PROFILER_H
@@ -65,6 +65,8 @@ public:
 	typedef void *(*PairCallback)(void *, uint32_t, T *, int, uint32_t, T *, int);
 	typedef void (*UnpairCallback)(void *, uint32_t, T *, int, uint32_t, T *, int, void *);
 	typedef void *(*CheckPairCallback)(void *, uint32_t, T *, int, uint32_t, T *, int, void *);
+	// Runs p_func(p_func_userdata, index) for every index in [0, p_count), possibly concurrently, and returns once all have completed.
+	typedef void (*ParallelForCallback)(void *, void (*)(void *, uint32_t), void *, uint32_t);
 
 	// allow locally toggling thread safety if the template has been compiled with BVH_THREAD_SAFE
 	void params_set_thread_safe(bool p_enable) {
@@ -98,6 +100,15 @@ public:
 		unpair_callback = p_callback;
 		unpair_callback_userdata = p_userdata;
 	}
+	// When set, the tree culls for pair finding are spread over the given parallel for, provided
+	// that at least p_min_items items have changed. Pair and unpair callbacks are still sent
+	// serially, in the same order as without it.
+	void set_parallel_pairing_callback(ParallelForCallback p_callback, void *p_userdata, uint32_t p_min_items) {
+		BVH_LOCKED_FUNCTION
+		parallel_pairing_callback = p_callback;
+		parallel_pairing_callback_userdata = p_userdata;
+		parallel_pairing_min_items = MAX(p_min_items, 1u);
+	}
 	void set_check_pair_callback(CheckPairCallback p_callback, void *p_userdata) {
 		BVH_LOCKED_FUNCTION
 		check_pair_callback = p_callback;
@@ -381,6 +392,36 @@ public:
 		return params.result_count_overall;
 	}
 
+	// Same as cull_segment, but neither locks nor uses shared state, so that many queries can run
+	// concurrently. The caller must make sure that nothing modifies the BVH in the meantime.
+	int cull_segment_concurrent(const POINT &p_from, const POINT &p_to, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) const {
+		typename BVHTREE_CLASS::CullParams params;
+
+		params.result_count_overall = 0;
+		params.result_max = p_result_max;
+		params.result_array = p_result_array;
+		params.subindex_array = p_subindex_array;
+		params.tester = p_tester;
+		params.tree_collision_mask = p_tree_collision_mask;
+
+		params.segment.from = p_from;
+		params.segment.to = p_to;
+
+		thread_local LocalVector<uint32_t, uint32_t, true> hits;
+		tree.cull_segment_hits(params, hits);
+
+		int result_count = MIN((int)hits.size(), p_result_max);
+		for (int n = 0; n < result_count; n++) {
+			const typename BVHTREE_CLASS::ItemExtra &ex = tree._extra[hits[n]];
+			p_result_array[n] = ex.userdata;
+			if (p_subindex_array) {
+				p_subindex_array[n] = ex.subindex;
+			}
+		}
+
+		return result_count;
+	}
+
 	int cull_point(const POINT &p_point, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
 		BVH_LOCKED_FUNCTION
 		typename BVHTREE_CLASS::CullParams params;
@@ -435,6 +476,11 @@ private:
 			return;
 		}
 
+		if (parallel_pairing_callback && changed_items.size() >= parallel_pairing_min_items) {
+			_check_for_collisions_parallel(p_full_check);
+			return;
+		}
+
 		BOUNDS bb;
 
 		typename BVHTREE_CLASS::CullParams params;
@@ -480,6 +526,55 @@ private:
 		_reset();
 	}
 
+	static void _cull_changed_item(void *p_self, uint32_t p_index) {
+		BVH_Manager *self = static_cast<BVH_Manager *>(p_self);
+		const BVHHandle &h = self->changed_items[p_index];
+
+		typename BVHTREE_CLASS::CullParams params;
+		params.result_count_overall = 0;
+		params.result_count = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+		self->tree.item_fill_cullparams(h, params);
+		params.abb.from(self->tree._pairs[h.id()].expanded_aabb);
+
+		self->tree.cull_aabb_hits(params, self->changed_item_hits[p_index]);
+	}
+
+	// Same result as the serial path: only the culls, which don't modify anything,
+	// run concurrently. Leavers and enterers are then processed in changed_items order,
+	// so the pair callbacks are sent in a deterministic order.
+	void _check_for_collisions_parallel(bool p_full_check) {
+		uint32_t changed_count = changed_items.size();
+		if (changed_item_hits.size() < changed_count) {
+			changed_item_hits.resize(changed_count);
+		}
+
+		parallel_pairing_callback(parallel_pairing_callback_userdata, &BVH_Manager::_cull_changed_item, this, changed_count);
+
+		for (uint32_t i = 0; i < changed_count; i++) {
+			const BVHHandle &h = changed_items[i];
+
+			BVHABB_CLASS abb;
+			abb.from(tree._pairs[h.id()].expanded_aabb);
+			_find_leavers(h, abb, p_full_check);
+
+			uint32_t changed_item_ref_id = h.id();
+			for (const uint32_t ref_id : changed_item_hits[i]) {
+				// don't collide against ourself
+				if (ref_id == changed_item_ref_id) {
+					continue;
+				}
+
+				BVHHandle h_collidee;
+				h_collidee.set_id(ref_id);
+				_collide(h, h_collidee);
+			}
+		}
+		_reset();
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, BOUNDS &r_aabb) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -765,12 +860,18 @@ private:
 	void *pair_callback_userdata = nullptr;
 	void *unpair_callback_userdata = nullptr;
 	void *check_pair_callback_userdata = nullptr;
+	ParallelForCallback parallel_pairing_callback = nullptr;
+	void *parallel_pairing_callback_userdata = nullptr;
+	uint32_t parallel_pairing_min_items = 1;
 
 	BVHTREE_CLASS tree;
 
 	// for collision pairing,
 	// maintain a list of all items moved etc on each frame / tick
 	LocalVector<BVHHandle, uint32_t, true> changed_items;
+
+	// Per changed item cull results for parallel pairing, kept around to reuse their memory.
+	LocalVector<LocalVector<uint32_t, uint32_t, true>> changed_item_hits;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
 	class BVHLockedFunction {
@@ -150,6 +150,7 @@ public:
 
 	virtual bool is_tool() const = 0;
 	virtual bool is_valid() const = 0;
+	virtual bool is_thread_safe() const { return false; } // Instances only touch their own subtree, so they can be processed on worker threads.
 
 	virtual ScriptLanguage *get_language() const = 0;
 
@@ -30,6 +30,7 @@
 
 #include "worker_thread_pool.h"
 
+#include "core/debugger/trace_profiler.h"
 #include "core/os/os.h"
 #include "core/os/thread_safe.h"
 
@@ -51,6 +52,8 @@ void WorkerThreadPool::_process_task_queue() {
 }
 
 void WorkerThreadPool::_process_task(Task *p_task) {
+	TRACE_SCOPE(p_task->group ? "WorkerThreadPool::group_task" : "WorkerThreadPool::task");
+
 	bool low_priority = p_task->low_priority;
 	int pool_thread_index = -1;
 	Task *prev_low_prio_task = nullptr; // In case this is recursively called.
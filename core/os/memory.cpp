@@ -61,6 +61,7 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 #ifdef DEBUG_ENABLED
 SafeNumeric<uint64_t> Memory::mem_usage;
 SafeNumeric<uint64_t> Memory::max_usage;
+SafeNumeric<uint64_t> Memory::total_allocs;
 #endif
 
 SafeNumeric<uint64_t> Memory::alloc_count;
@@ -77,6 +78,9 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 	ERR_FAIL_NULL_V(mem, nullptr);
 
 	alloc_count.increment();
+#ifdef DEBUG_ENABLED
+	total_allocs.increment();
+#endif
 
 	if (prepad) {
 		uint64_t *s = (uint64_t *)mem;
@@ -191,6 +195,14 @@ uint64_t Memory::get_mem_max_usage() {
 #endif
 }
 
+uint64_t Memory::get_total_allocs() {
+#ifdef DEBUG_ENABLED
+	return total_allocs.get();
+#else
+	return 0;
+#endif
+}
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
@@ -46,6 +46,7 @@ class Memory {
 #ifdef DEBUG_ENABLED
 	static SafeNumeric<uint64_t> mem_usage;
 	static SafeNumeric<uint64_t> max_usage;
+	static SafeNumeric<uint64_t> total_allocs;
 #endif
 
 	static SafeNumeric<uint64_t> alloc_count;
@@ -58,6 +59,7 @@ public:
 	static uint64_t get_mem_available();
 	static uint64_t get_mem_usage();
 	static uint64_t get_mem_max_usage();
+	static uint64_t get_total_allocs(); // Number of allocations since startup (debug builds only).
 };
 
 class DefaultAllocator {
@@ -1019,6 +1019,165 @@ struct _VariantCall {
 		return len;
 	}
 
+	// Bulk math for the numeric packed arrays. The loops only touch the raw buffers,
+	// so the compiler is free to vectorize them.
+
+	template <class T>
+	static void func_Packed_scale(Vector<T> *p_instance, double p_factor) {
+		const real_t factor = p_factor;
+		const int64_t size = p_instance->size();
+		T *w = p_instance->ptrw();
+		for (int64_t i = 0; i < size; i++) {
+			w[i] = w[i] * factor;
+		}
+	}
+
+	template <class T>
+	static void func_Packed_offset(Vector<T> *p_instance, const T &p_value) {
+		const int64_t size = p_instance->size();
+		T *w = p_instance->ptrw();
+		for (int64_t i = 0; i < size; i++) {
+			w[i] = w[i] + p_value;
+		}
+	}
+
+	template <class T>
+	static T func_Packed_sum(Vector<T> *p_instance) {
+		const int64_t size = p_instance->size();
+		if (size == 0) {
+			return T();
+		}
+		// Four independent partial sums, so each addition doesn't wait on the previous one and the compiler
+		// can keep them in vector registers. Core has no SIMD layer, this is the plain scalar path.
+		// The partial sums start from elements instead of T(), as the default Color isn't zero.
+		const T *r = p_instance->ptr();
+		T sum = r[0];
+		int64_t i = 1;
+		if (size >= 4) {
+			T sum1 = r[1];
+			T sum2 = r[2];
+			T sum3 = r[3];
+			for (i = 4; i + 3 < size; i += 4) {
+				sum = sum + r[i];
+				sum1 = sum1 + r[i + 1];
+				sum2 = sum2 + r[i + 2];
+				sum3 = sum3 + r[i + 3];
+			}
+			sum = (sum + sum1) + (sum2 + sum3);
+		}
+		for (; i < size; i++) {
+			sum = sum + r[i];
+		}
+		return sum;
+	}
+
+	template <class T>
+	static Vector<T> func_Packed_lerp(Vector<T> *p_instance, const Vector<T> &p_to, double p_weight) {
+		const int64_t size = p_instance->size();
+		Vector<T> dest;
+		ERR_FAIL_COND_V_MSG(p_to.size() != size, dest, "Packed arrays must have the same size to be interpolated.");
+		dest.resize(size);
+		const real_t weight = p_weight;
+		const T *from = p_instance->ptr();
+		const T *to = p_to.ptr();
+		T *w = dest.ptrw();
+		for (int64_t i = 0; i < size; i++) {
+			w[i] = from[i] + (to[i] - from[i]) * weight;
+		}
+		return dest;
+	}
+
+	template <class T>
+	static Vector<T> func_Packed_select(Vector<T> *p_instance, const PackedByteArray &p_mask, const Vector<T> &p_other) {
+		const int64_t size = p_instance->size();
+		ERR_FAIL_COND_V_MSG(p_mask.size() != size || p_other.size() != size, Vector<T>(), "The mask and the other array must have the same size as this array.");
+		Vector<T> dest = *p_instance;
+		const uint8_t *mask = p_mask.ptr();
+		const T *other = p_other.ptr();
+		T *w = dest.ptrw();
+		for (int64_t i = 0; i < size; i++) {
+			if (mask[i]) {
+				w[i] = other[i];
+			}
+		}
+		return dest;
+	}
+
+	// The PackedFloat32Array reductions below use four independent accumulators like `func_Packed_sum()`.
+
+	static double func_PackedFloat32Array_sum(PackedFloat32Array *p_instance) {
+		const int64_t size = p_instance->size();
+		const float *r = p_instance->ptr();
+		// Accumulated in double like `dot()`, so large arrays don't lose the small elements.
+		double sum[4] = { 0, 0, 0, 0 };
+		int64_t i = 0;
+		for (; i + 3 < size; i += 4) {
+			sum[0] += r[i];
+			sum[1] += r[i + 1];
+			sum[2] += r[i + 2];
+			sum[3] += r[i + 3];
+		}
+		for (; i < size; i++) {
+			sum[0] += r[i];
+		}
+		return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+	}
+
+	static float func_PackedFloat32Array_min(PackedFloat32Array *p_instance) {
+		const int64_t size = p_instance->size();
+		ERR_FAIL_COND_V_MSG(size == 0, 0, "Can't get the minimum of an empty array.");
+		const float *r = p_instance->ptr();
+		float result[4] = { r[0], r[0], r[0], r[0] };
+		int64_t i = 1;
+		for (; i + 3 < size; i += 4) {
+			result[0] = MIN(result[0], r[i]);
+			result[1] = MIN(result[1], r[i + 1]);
+			result[2] = MIN(result[2], r[i + 2]);
+			result[3] = MIN(result[3], r[i + 3]);
+		}
+		for (; i < size; i++) {
+			result[0] = MIN(result[0], r[i]);
+		}
+		return MIN(MIN(result[0], result[1]), MIN(result[2], result[3]));
+	}
+
+	static float func_PackedFloat32Array_max(PackedFloat32Array *p_instance) {
+		const int64_t size = p_instance->size();
+		ERR_FAIL_COND_V_MSG(size == 0, 0, "Can't get the maximum of an empty array.");
+		const float *r = p_instance->ptr();
+		float result[4] = { r[0], r[0], r[0], r[0] };
+		int64_t i = 1;
+		for (; i + 3 < size; i += 4) {
+			result[0] = MAX(result[0], r[i]);
+			result[1] = MAX(result[1], r[i + 1]);
+			result[2] = MAX(result[2], r[i + 2]);
+			result[3] = MAX(result[3], r[i + 3]);
+		}
+		for (; i < size; i++) {
+			result[0] = MAX(result[0], r[i]);
+		}
+		return MAX(MAX(result[0], result[1]), MAX(result[2], result[3]));
+	}
+
+	static double func_PackedFloat32Array_dot(PackedFloat32Array *p_instance, const PackedFloat32Array &p_with) {
+		const int64_t size = p_instance->size();
+		ERR_FAIL_COND_V_MSG(p_with.size() != size, 0, "Packed arrays must have the same size to compute their dot product.");
+		const float *a = p_instance->ptr();
+		const float *b = p_with.ptr();
+		double dot[4] = { 0, 0, 0, 0 };
+		int64_t i = 0;
+		for (; i + 3 < size; i += 4) {
+			dot[0] += double(a[i]) * b[i];
+			dot[1] += double(a[i + 1]) * b[i + 1];
+			dot[2] += double(a[i + 2]) * b[i + 2];
+			dot[3] += double(a[i + 3]) * b[i + 3];
+		}
+		for (; i < size; i++) {
+			dot[0] += double(a[i]) * b[i];
+		}
+		return (dot[0] + dot[1]) + (dot[2] + dot[3]);
+	}
+
 	static void func_Callable_call(Variant *v, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
 		Callable *callable = VariantGetInternalPtr<Callable>::get_ptr(v);
 		callable->callp(p_args, p_argcount, r_ret, r_error);
@@ -2384,6 +2543,15 @@ static void _register_variant_builtin_methods() {
 	bind_method(PackedFloat32Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedFloat32Array, count, sarray("value"), varray());
 
+	bind_functionnc(PackedFloat32Array, scale, _VariantCall::func_Packed_scale<float>, sarray("factor"), varray());
+	bind_functionnc(PackedFloat32Array, offset, _VariantCall::func_Packed_offset<float>, sarray("value"), varray());
+	bind_function(PackedFloat32Array, sum, _VariantCall::func_PackedFloat32Array_sum, sarray(), varray());
+	bind_function(PackedFloat32Array, lerp, _VariantCall::func_Packed_lerp<float>, sarray("to", "weight"), varray());
+	bind_function(PackedFloat32Array, select, _VariantCall::func_Packed_select<float>, sarray("mask", "other"), varray());
+	bind_function(PackedFloat32Array, min, _VariantCall::func_PackedFloat32Array_min, sarray(), varray());
+	bind_function(PackedFloat32Array, max, _VariantCall::func_PackedFloat32Array_max, sarray(), varray());
+	bind_function(PackedFloat32Array, dot, _VariantCall::func_PackedFloat32Array_dot, sarray("with"), varray());
+
 	/* Float64 Array */
 
 	bind_method(PackedFloat64Array, size, sarray(), varray());
@@ -2456,6 +2624,12 @@ static void _register_variant_builtin_methods() {
 	bind_method(PackedVector2Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector2Array, count, sarray("value"), varray());
 
+	bind_functionnc(PackedVector2Array, scale, _VariantCall::func_Packed_scale<Vector2>, sarray("factor"), varray());
+	bind_functionnc(PackedVector2Array, offset, _VariantCall::func_Packed_offset<Vector2>, sarray("value"), varray());
+	bind_function(PackedVector2Array, sum, _VariantCall::func_Packed_sum<Vector2>, sarray(), varray());
+	bind_function(PackedVector2Array, lerp, _VariantCall::func_Packed_lerp<Vector2>, sarray("to", "weight"), varray());
+	bind_function(PackedVector2Array, select, _VariantCall::func_Packed_select<Vector2>, sarray("mask", "other"), varray());
+
 	/* Vector3 Array */
 
 	bind_method(PackedVector3Array, size, sarray(), varray());
@@ -2480,6 +2654,12 @@ static void _register_variant_builtin_methods() {
 	bind_method(PackedVector3Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector3Array, count, sarray("value"), varray());
 
+	bind_functionnc(PackedVector3Array, scale, _VariantCall::func_Packed_scale<Vector3>, sarray("factor"), varray());
+	bind_functionnc(PackedVector3Array, offset, _VariantCall::func_Packed_offset<Vector3>, sarray("value"), varray());
+	bind_function(PackedVector3Array, sum, _VariantCall::func_Packed_sum<Vector3>, sarray(), varray());
+	bind_function(PackedVector3Array, lerp, _VariantCall::func_Packed_lerp<Vector3>, sarray("to", "weight"), varray());
+	bind_function(PackedVector3Array, select, _VariantCall::func_Packed_select<Vector3>, sarray("mask", "other"), varray());
+
 	/* Color Array */
 
 	bind_method(PackedColorArray, size, sarray(), varray());
@@ -2504,6 +2684,12 @@ static void _register_variant_builtin_methods() {
 	bind_method(PackedColorArray, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedColorArray, count, sarray("value"), varray());
 
+	bind_functionnc(PackedColorArray, scale, _VariantCall::func_Packed_scale<Color>, sarray("factor"), varray());
+	bind_functionnc(PackedColorArray, offset, _VariantCall::func_Packed_offset<Color>, sarray("value"), varray());
+	bind_function(PackedColorArray, sum, _VariantCall::func_Packed_sum<Color>, sarray(), varray());
+	bind_function(PackedColorArray, lerp, _VariantCall::func_Packed_lerp<Color>, sarray("to", "weight"), varray());
+	bind_function(PackedColorArray, select, _VariantCall::func_Packed_select<Color>, sarray("mask", "other"), varray());
+
 	/* Register constants */
 
 	int ncc = Color::get_named_color_count();
@@ -35,6 +35,7 @@
 #include "core/core_string_names.h"
 #include "core/crypto/crypto.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/trace_profiler.h"
 #include "core/extension/extension_api_dump.h"
 #include "core/extension/gdextension_interface_dump.gen.h"
 #include "core/extension/gdextension_manager.h"
@@ -167,6 +168,9 @@ static bool single_window = false;
 static bool editor = false;
 static bool project_manager = false;
 static bool cmdline_tool = false;
+static bool server_profile = false;
+static int trace_frames = -1; // Frames left to capture with the trace profiler.
+static String trace_file = "user://frame_trace.json";
 static String locale;
 static bool show_help = false;
 static uint64_t quit_after = 0;
@@ -396,6 +400,7 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("  --path <directory>                Path to a project (<directory> must contain a 'project.godot' file).\n");
 	OS::get_singleton()->print("  -u, --upwards                     Scan folders upwards for project.godot file.\n");
 	OS::get_singleton()->print("  --main-pack <file>                Path to a pack (.pck) file to load.\n");
+	OS::get_singleton()->print("  --boot-image <file>               Load project settings and the global class cache from a binary boot image, (re)generating it when missing or stale.\n");
 	OS::get_singleton()->print("  --render-thread <mode>            Render thread mode ['unsafe', 'safe', 'separate'].\n");
 	OS::get_singleton()->print("  --remote-fs <address>             Remote filesystem (<host/IP>[:<port>] address).\n");
 	OS::get_singleton()->print("  --remote-fs-password <password>   Password for remote filesystem.\n");
@@ -434,6 +439,7 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("  --text-driver <driver>            Text driver (Fonts, BiDi, shaping).\n");
 	OS::get_singleton()->print("  --tablet-driver <driver>          Pen tablet input driver.\n");
 	OS::get_singleton()->print("  --headless                        Enable headless mode (--display-driver headless --audio-driver Dummy). Useful for servers and with --script.\n");
+	OS::get_singleton()->print("  --server                          Enable the dedicated server profile (implies --headless). Rendering, audio mixing, text shaping, XR and the boot splash are skipped entirely.\n");
 	OS::get_singleton()->print("  --write-movie <file>              Writes a video to the specified path (usually with .avi or .png extension).\n");
 	OS::get_singleton()->print("                                    --fixed-fps is forced when enabled, but it can be used to change movie FPS.\n");
 	OS::get_singleton()->print("                                    --disable-vsync can speed up movie writing but makes interaction more difficult.\n");
@@ -479,8 +485,12 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("  --disable-render-loop             Disable render loop so rendering only occurs when called explicitly from script.\n");
 	OS::get_singleton()->print("  --disable-crash-handler           Disable crash handler when supported by the platform code.\n");
 	OS::get_singleton()->print("  --fixed-fps <fps>                 Force a fixed number of frames per second. This setting disables real-time synchronization.\n");
+	OS::get_singleton()->print("  --deterministic-steps <steps>     Simulate exactly this number of physics ticks per frame, regardless of real time. Unthrottled when headless.\n");
 	OS::get_singleton()->print("  --delta-smoothing <enable>        Enable or disable frame delta smoothing ['enable', 'disable'].\n");
 	OS::get_singleton()->print("  --print-fps                       Print the frames per second to the stdout.\n");
+#ifdef MODULE_GDSCRIPT_ENABLED
+	OS::get_singleton()->print("  --gdscript-opt-level <level>      Set the GDScript compiler optimization level (0 disables the optimization passes, 1 is the default).\n");
+#endif
 	OS::get_singleton()->print("\n");
 
 	OS::get_singleton()->print("Standalone tools:\n");
@@ -509,6 +519,8 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("  --dump-extension-api              Generate JSON dump of the Godot API for GDExtension bindings named 'extension_api.json' in the current folder.\n");
 	OS::get_singleton()->print("  --validate-extension-api <path>   Validate an extension API file dumped (with the option above) from a previous version of the engine to ensure API compatibility. If incompatibilities or errors are detected, the return code will be non zero.\n");
 	OS::get_singleton()->print("  --benchmark                       Benchmark the run time and print it to console.\n");
+	OS::get_singleton()->print("  --trace-frames <frames>           Record a CPU timeline of the given number of frames and save it in the Chrome trace format (readable by Perfetto).\n");
+	OS::get_singleton()->print("  --trace-file <path>               Path of the trace saved by --trace-frames (default: user://frame_trace.json).\n");
 	OS::get_singleton()->print("  --benchmark-file <path>           Benchmark the run time and save it to a given file in JSON format. The path should be absolute.\n");
 #ifdef TESTS_ENABLED
 	OS::get_singleton()->print("  --test [--help]                   Run unit tests. Use --test --help for more information.\n");
@@ -808,6 +820,7 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 	String debug_uri = "";
 	bool skip_breakpoints = false;
 	String main_pack;
+	String boot_image;
 	bool quiet_stdout = false;
 	int rtm = -1;
 
@@ -1147,6 +1160,12 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			audio_driver = NULL_AUDIO_DRIVER;
 			display_driver = NULL_DISPLAY_DRIVER;
 
+		} else if (I->get() == "--server") { // enable the dedicated server profile (headless, no rendering or audio processing at all).
+
+			audio_driver = NULL_AUDIO_DRIVER;
+			display_driver = NULL_DISPLAY_DRIVER;
+			server_profile = true;
+
 		} else if (I->get() == "--profiling") { // enable profiling
 
 			use_debug_profiler = true;
@@ -1405,6 +1424,15 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 				goto error;
 			};
 
+		} else if (I->get() == "--boot-image") {
+			if (I->next()) {
+				boot_image = I->next()->get();
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing path to boot image file, aborting.\n");
+				goto error;
+			};
+
 		} else if (I->get() == "-d" || I->get() == "--debug") {
 			debug_uri = "local://";
 			OS::get_singleton()->_debug_stdout = true;
@@ -1451,6 +1479,14 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 				OS::get_singleton()->print("Missing fixed-fps argument, aborting.\n");
 				goto error;
 			}
+		} else if (I->get() == "--deterministic-steps") {
+			if (I->next()) {
+				engine->set_deterministic_physics_steps(I->next()->get().to_int());
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing deterministic-steps argument, aborting.\n");
+				goto error;
+			}
 		} else if (I->get() == "--write-movie") {
 			if (I->next()) {
 				Engine::get_singleton()->set_write_movie_path(I->next()->get());
@@ -1492,6 +1528,32 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 				goto error;
 			}
 
+		} else if (I->get() == "--trace-frames") {
+			if (I->next()) {
+				trace_frames = MAX(0, I->next()->get().to_int());
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing <frames> argument for --trace-frames <frames>.\n");
+				goto error;
+			}
+		} else if (I->get() == "--trace-file") {
+			if (I->next()) {
+				trace_file = I->next()->get();
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing <path> argument for --trace-file <path>.\n");
+				goto error;
+			}
+#ifdef MODULE_GDSCRIPT_ENABLED
+		} else if (I->get() == "--gdscript-opt-level") {
+			if (I->next()) {
+				GDScriptLanguage::set_optimization_level(I->next()->get().to_int());
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing <level> argument for --gdscript-opt-level <level>.\n");
+				goto error;
+			}
+#endif
 		} else if (I->get() == "--benchmark") {
 			OS::get_singleton()->set_use_benchmark(true);
 		} else if (I->get() == "--benchmark-file") {
@@ -1540,6 +1602,11 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 		}
 	}
 
+	if (!boot_image.is_empty() && !editor) {
+		// The editor changes settings and script classes all the time, the image would always be stale.
+		globals->set_boot_image_path(boot_image);
+	}
+
 	if (globals->setup(project_path, main_pack, upwards, editor) == OK) {
 #ifdef TOOLS_ENABLED
 		found_project = true;
@@ -1934,6 +2001,9 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 		if (editor || project_manager) {
 			// Editor and project manager cannot run with rendering in a separate thread (they will crash on startup).
 			rtm = OS::RENDER_THREAD_SAFE;
+		} else if (server_profile) {
+			// Nothing is ever drawn, so a render thread would only add synchronization overhead.
+			rtm = OS::RENDER_THREAD_SAFE;
 		}
 		OS::get_singleton()->_render_thread_mode = OS::RenderThreadMode(rtm);
 	}
@@ -1987,6 +2057,12 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 		AudioDriverDummy::get_dummy_singleton()->set_use_threads(false);
 	}
 
+	if (server_profile) {
+		// Nobody listens on a dedicated server, don't spawn the dummy driver's mixing thread.
+		audio_driver_idx = AudioDriverManager::get_driver_count() - 1;
+		AudioDriverDummy::get_dummy_singleton()->set_use_threads(false);
+	}
+
 	{
 		window_orientation = DisplayServer::ScreenOrientation(int(GLOBAL_DEF_BASIC("display/window/handheld/orientation", DisplayServer::ScreenOrientation::SCREEN_LANDSCAPE)));
 	}
@@ -2389,6 +2465,10 @@ Error Main::setup2() {
 	bool show_logo = true;
 #endif
 
+	if (server_profile) {
+		show_logo = false;
+	}
+
 	if (init_windowed) {
 		//do none..
 	} else if (init_maximized) {
@@ -2519,6 +2599,11 @@ Error Main::setup2() {
 	ProjectSettings::get_singleton()->set_custom_property_info(PropertyInfo(Variant::STRING, "internationalization/rendering/text_driver", PROPERTY_HINT_ENUM, text_driver_options));
 
 	/* Determine text driver */
+	if (text_driver.is_empty() && server_profile) {
+		// A dedicated server never shapes or draws text, use the dummy text server
+		// so that no shaping library or support data is loaded.
+		text_driver = "Dummy";
+	}
 	if (text_driver.is_empty()) {
 		text_driver = GLOBAL_GET("internationalization/rendering/text_driver");
 	}
@@ -2641,6 +2726,11 @@ Error Main::setup2() {
 		rendering_server->global_shader_parameters_load_settings(!editor);
 	}
 
+	if (!globals->get_boot_image_path().is_empty()) {
+		// Only written if it was missing or stale.
+		globals->save_boot_image();
+	}
+
 	_start_success = true;
 
 	ClassDB::set_current_api(ClassDB::API_NONE); //no more APIs are registered at this point
@@ -2775,7 +2865,7 @@ bool Main::start() {
 	}
 
 	uint64_t minimum_time_msec = GLOBAL_DEF(PropertyInfo(Variant::INT, "application/boot_splash/minimum_display_time", PROPERTY_HINT_RANGE, "0,100,1,or_greater,suffix:ms"), 0);
-	if (Engine::get_singleton()->is_editor_hint()) {
+	if (Engine::get_singleton()->is_editor_hint() || server_profile) {
 		minimum_time_msec = 0;
 	}
 
@@ -3406,10 +3496,30 @@ static uint64_t physics_process_max = 0;
 static uint64_t process_max = 0;
 static uint64_t navigation_process_max = 0;
 
+static void _save_frame_trace() {
+	TraceProfiler::end_capture();
+	Error err = TraceProfiler::save_chrome_trace(trace_file);
+	if (err == OK) {
+		print_line("Frame trace saved to: " + ProjectSettings::get_singleton()->globalize_path(trace_file));
+	}
+}
+
 bool Main::iteration() {
 	//for now do not error on this
 	//ERR_FAIL_COND_V(iterating, false);
 
+	if (trace_frames > 0) {
+		if (!TraceProfiler::is_capturing()) {
+			TraceProfiler::begin_capture();
+		}
+		trace_frames--;
+	} else if (trace_frames == 0 && TraceProfiler::is_capturing()) {
+		_save_frame_trace();
+		trace_frames = -1;
+	}
+
+	TRACE_SCOPE("Main::iteration");
+
 	iterating++;
 
 	const uint64_t ticks = OS::get_singleton()->get_ticks_usec();
@@ -3417,6 +3527,15 @@ bool Main::iteration() {
 	main_timer_sync.set_cpu_ticks_usec(ticks);
 	main_timer_sync.set_fixed_fps(fixed_fps);
 
+	int deterministic_steps = -1;
+	if (Engine::get_singleton()->external_physics_clock) {
+		deterministic_steps = Engine::get_singleton()->_external_physics_ticks;
+		Engine::get_singleton()->_external_physics_ticks = 0;
+	} else if (Engine::get_singleton()->deterministic_physics_steps > 0) {
+		deterministic_steps = Engine::get_singleton()->deterministic_physics_steps;
+	}
+	main_timer_sync.set_deterministic_steps(deterministic_steps);
+
 	const uint64_t ticks_elapsed = ticks - last_ticks;
 
 	const int physics_ticks_per_second = Engine::get_singleton()->get_physics_ticks_per_second();
@@ -3440,7 +3559,7 @@ bool Main::iteration() {
 	last_ticks = ticks;
 
 	const int max_physics_steps = Engine::get_singleton()->get_max_physics_steps_per_frame();
-	if (fixed_fps == -1 && advance.physics_steps > max_physics_steps) {
+	if (fixed_fps == -1 && deterministic_steps == -1 && advance.physics_steps > max_physics_steps) {
 		process_step -= (advance.physics_steps - max_physics_steps) * physics_step;
 		advance.physics_steps = max_physics_steps;
 	}
@@ -3448,9 +3567,13 @@ bool Main::iteration() {
 	bool exit = false;
 
 	// process all our active interfaces
-	XRServer::get_singleton()->_process();
+	if (!server_profile) {
+		XRServer::get_singleton()->_process();
+	}
 
 	for (int iters = 0; iters < advance.physics_steps; ++iters) {
+		TRACE_SCOPE("Main::physics_step");
+
 		if (Input::get_singleton()->is_using_input_buffering() && agile_input_event_flushing) {
 			Input::get_singleton()->flush_buffered_events();
 		}
@@ -3508,19 +3631,24 @@ bool Main::iteration() {
 	}
 	message_queue->flush();
 
-	RenderingServer::get_singleton()->sync(); //sync if still drawing from previous frames.
+	// A dedicated server never draws, so the rendering server does not need to be synced or flushed either.
+	if (!server_profile) {
+		RenderingServer::get_singleton()->sync(); //sync if still drawing from previous frames.
 
-	if (DisplayServer::get_singleton()->can_any_window_draw() &&
-			RenderingServer::get_singleton()->is_render_loop_enabled()) {
-		if ((!force_redraw_requested) && OS::get_singleton()->is_in_low_processor_usage_mode()) {
-			if (RenderingServer::get_singleton()->has_changed()) {
+		if (DisplayServer::get_singleton()->can_any_window_draw() &&
+				RenderingServer::get_singleton()->is_render_loop_enabled()) {
+			TRACE_SCOPE("RenderingServer::draw");
+
+			if ((!force_redraw_requested) && OS::get_singleton()->is_in_low_processor_usage_mode()) {
+				if (RenderingServer::get_singleton()->has_changed()) {
+					RenderingServer::get_singleton()->draw(true, scaled_step); // flush visual commands
+					Engine::get_singleton()->frames_drawn++;
+				}
+			} else {
 				RenderingServer::get_singleton()->draw(true, scaled_step); // flush visual commands
 				Engine::get_singleton()->frames_drawn++;
+				force_redraw_requested = false;
 			}
-		} else {
-			RenderingServer::get_singleton()->draw(true, scaled_step); // flush visual commands
-			Engine::get_singleton()->frames_drawn++;
-			force_redraw_requested = false;
 		}
 	}
 
@@ -3586,6 +3714,11 @@ bool Main::iteration() {
 		return exit;
 	}
 
+	if (deterministic_steps != -1 && !Engine::get_singleton()->external_physics_clock && !DisplayServer::get_singleton()->can_any_window_draw()) {
+		// Nothing to present, simulate faster than real time.
+		return exit;
+	}
+
 	OS::get_singleton()->add_frame_delay(DisplayServer::get_singleton()->window_can_draw());
 
 #ifdef TOOLS_ENABLED
@@ -3632,6 +3765,11 @@ void Main::cleanup(bool p_force) {
 		movie_writer->end();
 	}
 
+	if (TraceProfiler::is_capturing()) {
+		// Quitting before all the requested frames were captured, save what we have.
+		_save_frame_trace();
+	}
+
 	ResourceLoader::clear_thread_load_tasks();
 
 	ResourceLoader::remove_custom_loaders();
@@ -3755,6 +3893,8 @@ void Main::cleanup(bool p_force) {
 	message_queue->flush();
 	memdelete(message_queue);
 
+	TraceProfiler::clear();
+
 	unregister_core_driver_types();
 	unregister_core_extensions();
 	uninitialize_modules(MODULE_INITIALIZATION_LEVEL_CORE);
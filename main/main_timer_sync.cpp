@@ -486,6 +486,21 @@ MainFrameTime MainTimerSync::advance_checked(double p_physics_step, int p_physic
 	return ret;
 }
 
+// returns exactly deterministic_steps physics steps, with a process step of the same length
+MainFrameTime MainTimerSync::advance_deterministic(double p_physics_step) {
+	MainFrameTime ret;
+
+	ret.physics_steps = deterministic_steps;
+	ret.process_step = deterministic_steps * p_physics_step;
+	ret.interpolation_fraction = 0;
+
+	// forget about leftovers of the adaptive mode, so it starts clean when switching back
+	time_accum = 0;
+	time_deficit = 0;
+
+	return ret;
+}
+
 // determine wall clock step since last iteration
 double MainTimerSync::get_cpu_process_step() {
 	uint64_t cpu_ticks_elapsed = current_cpu_ticks_usec - last_cpu_ticks_usec;
@@ -517,9 +532,18 @@ void MainTimerSync::set_fixed_fps(int p_fixed_fps) {
 	fixed_fps = p_fixed_fps;
 }
 
+void MainTimerSync::set_deterministic_steps(int p_deterministic_steps) {
+	deterministic_steps = p_deterministic_steps;
+}
+
 // advance one physics frame, return timesteps to take
 MainFrameTime MainTimerSync::advance(double p_physics_step, int p_physics_ticks_per_second) {
+	// always measured, so the wall clock doesn't jump when leaving deterministic mode
 	double cpu_process_step = get_cpu_process_step();
 
+	if (deterministic_steps >= 0) {
+		return advance_deterministic(p_physics_step);
+	}
+
 	return advance_checked(p_physics_step, p_physics_ticks_per_second, cpu_process_step);
 }
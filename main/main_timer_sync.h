@@ -129,6 +129,9 @@ class MainTimerSync {
 
 	int fixed_fps = 0;
 
+	// exact number of physics steps to take each frame regardless of wall clock time, -1 to adapt to wall clock time
+	int deterministic_steps = -1;
+
 protected:
 	// returns the fraction of p_physics_step required for the timer to overshoot
 	// before advance_core considers changing the physics_steps return from
@@ -145,6 +148,9 @@ protected:
 	// calls advance_core, keeps track of deficit it adds to animaption_step, make sure the deficit sum stays close to zero
 	MainFrameTime advance_checked(double p_physics_step, int p_physics_ticks_per_second, double p_process_step);
 
+	// returns exactly deterministic_steps physics steps, with a process step of the same length
+	MainFrameTime advance_deterministic(double p_physics_step);
+
 	// determine wall clock step since last iteration
 	double get_cpu_process_step();
 
@@ -157,6 +163,8 @@ public:
 	void set_cpu_ticks_usec(uint64_t p_cpu_ticks_usec);
 	//set fixed fps
 	void set_fixed_fps(int p_fixed_fps);
+	//set number of physics steps per frame, -1 to disable
+	void set_deterministic_steps(int p_deterministic_steps);
 
 	// advance one frame, return timesteps to take
 	MainFrameTime advance(double p_physics_step, int p_physics_ticks_per_second);
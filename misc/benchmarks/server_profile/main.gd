@@ -0,0 +1,61 @@
+extends Node
+
+# Measures startup time and per-tick CPU time of a dedicated server workload:
+# physics bodies, script processing and timers, and nothing that renders.
+#
+# Compare the server profile against plain headless mode with:
+#
+#     godot --server --fixed-fps 60 --path misc/benchmarks/server_profile
+#     godot --headless --fixed-fps 60 --path misc/benchmarks/server_profile
+#
+# --fixed-fps makes the main loop run as fast as it can, so the time per tick
+# is the CPU time of one iteration rather than the physics tick rate.
+
+const BODY_COUNT = 500
+const SCRIPTED_NODE_COUNT = 2000
+const WARMUP_TICKS = 60
+const MEASURED_TICKS = 600
+
+var ticks := 0
+var measure_begin_usec := 0
+
+
+class ScriptedNode extends Node:
+	var counter := 0
+
+	func _process(_delta):
+		counter += 1
+
+
+func _ready():
+	print("Startup: %.2f ms" % (Time.get_ticks_usec() / 1000.0))
+
+	var floor_body := StaticBody3D.new()
+	var floor_shape := CollisionShape3D.new()
+	floor_shape.shape = WorldBoundaryShape3D.new()
+	floor_body.add_child(floor_shape)
+	add_child(floor_body)
+
+	var sphere := SphereShape3D.new()
+	for i in BODY_COUNT:
+		var body := RigidBody3D.new()
+		var shape := CollisionShape3D.new()
+		shape.shape = sphere
+		body.add_child(shape)
+		body.position = Vector3((i % 20) * 2.5, 1.0 + floorf(i / 20.0) * 2.5, 0.0)
+		add_child(body)
+
+	for i in SCRIPTED_NODE_COUNT:
+		add_child(ScriptedNode.new())
+
+
+func _physics_process(_delta):
+	ticks += 1
+	if ticks == WARMUP_TICKS:
+		measure_begin_usec = Time.get_ticks_usec()
+	elif ticks == WARMUP_TICKS + MEASURED_TICKS:
+		var elapsed_usec := Time.get_ticks_usec() - measure_begin_usec
+		print("Time per tick: %.3f ms" % (elapsed_usec / 1000.0 / MEASURED_TICKS))
+		print("Physics process time: %.3f ms" % (Performance.get_monitor(Performance.TIME_PHYSICS_PROCESS) * 1000.0))
+		print("Static memory: %.2f MiB" % (Performance.get_monitor(Performance.MEMORY_STATIC) / 1048576.0))
+		get_tree().quit()
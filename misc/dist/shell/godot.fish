@@ -55,6 +55,7 @@ complete -c godot -s l -l language -d "Use a specific locale (<locale> being a t
 complete -c godot -l path -d "Path to a project (<directory> must contain a 'project.godot' file)" -r
 complete -c godot -s u -l upwards -d "Scan folders upwards for project.godot file"
 complete -c godot -l main-pack -d "Path to a pack (.pck) file to load" -r
+complete -c godot -l boot-image -d "Load project settings and the global class cache from a binary boot image" -r
 complete -c godot -l render-thread -d "Set the render thread mode" -x -a "unsafe safe separate"
 complete -c godot -l remote-fs -d "Use a remote filesystem (<host/IP>[:<port>] address)" -x
 complete -c godot -l remote-fs-password -d "Password for remote filesystem" -x
@@ -67,6 +68,7 @@ complete -c godot -l gpu-index -d "Use a specific GPU (run with --verbose to get
 complete -c godot -l text-driver -d "Set the text driver" -x
 complete -c godot -l tablet-driver -d "Set the pen tablet input driver" -x
 complete -c godot -l headless -d "Enable headless mode (--display-driver headless --audio-driver Dummy). Useful for servers and with --script"
+complete -c godot -l server -d "Enable the dedicated server profile (implies --headless). Rendering, audio mixing, XR and the boot splash are skipped entirely"
 complete -c godot -l write-movie -d "Writes a video to the specified path (usually with .avi or .png extension). --fixed-fps is forced when enabled" -x
 
 # Display options:
@@ -96,7 +98,9 @@ complete -c godot -l time-scale -d "Force time scale (higher values are faster,
 complete -c godot -l disable-render-loop -d "Disable render loop so rendering only occurs when called explicitly from script"
 complete -c godot -l disable-crash-handler -d "Disable crash handler when supported by the platform code"
 complete -c godot -l fixed-fps -d "Force a fixed number of frames per second (this setting disables real-time synchronization)" -x
+complete -c godot -l deterministic-steps -d "Simulate exactly this number of physics ticks per frame, regardless of real time" -x
 complete -c godot -l print-fps -d "Print the frames per second to the stdout"
+complete -c godot -l gdscript-opt-level -d "Set the GDScript compiler optimization level" -x
 
 # Standalone tools:
 complete -c godot -s s -l script -d "Run a script" -r
@@ -111,6 +115,8 @@ complete -c godot -l no-docbase -d "Disallow dumping the base types (used with -
 complete -c godot -l build-solutions -d "Build the scripting solutions (e.g. for C# projects)"
 complete -c godot -l dump-gdextension-interface -d "Generate GDExtension header file 'gdextension_interface.h' in the current folder. This file is the base file required to implement a GDExtension"
 complete -c godot -l dump-extension-api -d "Generate JSON dump of the Godot API for GDExtension bindings named 'extension_api.json' in the current folder"
+complete -c godot -l trace-frames -d "Record a CPU trace of the given number of frames" -x
+complete -c godot -l trace-file -d "Path of the Chrome trace file written by --trace-frames" -x
 complete -c godot -l benchmark -d "Benchmark the run time and print it to console"
 complete -c godot -l benchmark-file -d "Benchmark the run time and save it to a given file in JSON format" -x
 complete -c godot -l test -d "Run all unit tests; run with '--test --help' for more information" -x
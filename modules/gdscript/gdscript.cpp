@@ -52,6 +52,7 @@
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/os/os.h"
+#include "scene/main/scene_tree.h"
 
 #ifdef TOOLS_ENABLED
 #include "editor/editor_paths.h"
@@ -417,6 +418,7 @@ void GDScript::set_source_code(const String &p_code) {
 		return;
 	}
 	source = p_code;
+	binary_tokens.clear();
 #ifdef TOOLS_ENABLED
 	source_changed_cache = true;
 #endif
@@ -724,7 +726,7 @@ Error GDScript::reload(bool p_keep_state) {
 
 	valid = false;
 	GDScriptParser parser;
-	Error err = parser.parse(source, path, false);
+	Error err = binary_tokens.is_empty() ? parser.parse(source, path, false) : parser.parse_binary(binary_tokens, path);
 	if (err) {
 		if (EngineDebugger::is_active()) {
 			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
@@ -994,8 +996,18 @@ Error GDScript::load_source_code(const String &p_path) {
 		return OK;
 	}
 
-	Vector<uint8_t> sourcef;
 	Error err;
+	String remapped_path = ResourceLoader::path_remap(p_path);
+	if (remapped_path.get_extension().to_lower() == "gdc") {
+		// Exported as binary tokens, there is no source code to read.
+		Vector<uint8_t> buffer = FileAccess::get_file_as_bytes(remapped_path, &err);
+		ERR_FAIL_COND_V_MSG(err, err, "Attempt to open script '" + remapped_path + "' resulted in error '" + error_names[err] + "'.");
+		set_binary_tokens_source(buffer);
+		path = p_path;
+		return OK;
+	}
+
+	Vector<uint8_t> sourcef;
 	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
 	if (err) {
 		const char *err_name;
@@ -1020,6 +1032,7 @@ Error GDScript::load_source_code(const String &p_path) {
 	}
 
 	source = s;
+	binary_tokens.clear();
 	path = p_path;
 #ifdef TOOLS_ENABLED
 	source_changed_cache = true;
@@ -1029,6 +1042,15 @@ Error GDScript::load_source_code(const String &p_path) {
 	return OK;
 }
 
+void GDScript::set_binary_tokens_source(const Vector<uint8_t> &p_binary_tokens) {
+	binary_tokens = p_binary_tokens;
+	source = String();
+}
+
+const Vector<uint8_t> &GDScript::get_binary_tokens_source() const {
+	return binary_tokens;
+}
+
 const HashMap<StringName, GDScriptFunction *> &GDScript::debug_get_member_functions() const {
 	return member_functions;
 }
@@ -1057,6 +1079,26 @@ Ref<GDScript> GDScript::get_base() const {
 	return base;
 }
 
+SafeNumeric<uint32_t> GDScript::last_member_layout_id;
+
+uint64_t GDScript::get_member_cache_entry(const StringName &p_name) const {
+	HashMap<StringName, MemberInfo>::ConstIterator E = member_indices.find(p_name);
+	if (!E || E->value.getter != StringName() || E->value.setter != StringName() || E->value.index > MEMBER_CACHE_INDEX_MASK) {
+		return 0;
+	}
+
+	uint64_t type = MEMBER_CACHE_TYPE_ANY;
+	const GDScriptDataType &data_type = E->value.data_type;
+	if (data_type.has_type) {
+		if (data_type.kind == GDScriptDataType::BUILTIN && !data_type.has_container_element_type()) {
+			type = data_type.builtin_type + 1;
+		} else {
+			type = MEMBER_CACHE_TYPE_CHECKED;
+		}
+	}
+	return (uint64_t(member_layout_id) << 32) | (type << MEMBER_CACHE_TYPE_SHIFT) | uint64_t(E->value.index);
+}
+
 bool GDScript::inherits_script(const Ref<Script> &p_script) const {
 	Ref<GDScript> gd = p_script;
 	if (gd.is_null()) {
@@ -1966,6 +2008,7 @@ GDScriptInstance::~GDScriptInstance() {
 /************* SCRIPT LANGUAGE **************/
 
 GDScriptLanguage *GDScriptLanguage::singleton = nullptr;
+int GDScriptLanguage::optimization_level = 1;
 
 String GDScriptLanguage::get_name() const {
 	return "GDScript";
@@ -2055,6 +2098,9 @@ String GDScriptLanguage::get_extension() const {
 void GDScriptLanguage::finish() {
 	_call_stack.free();
 
+	frame_awaits[0].clear();
+	frame_awaits[1].clear();
+
 	// Clear the cache before parsing the script_list
 	GDScriptCache::clear();
 
@@ -2088,6 +2134,60 @@ void GDScriptLanguage::finish() {
 	}
 	script_list.clear();
 	function_list.clear();
+
+	GDScriptFunctionState::clear_stack_pool();
+}
+
+bool GDScriptLanguage::await_next_frame(const Signal &p_signal, const Ref<GDScriptFunctionState> &p_state) {
+	if (p_signal.get_name() != SNAME("process_frame")) {
+		return false;
+	}
+	SceneTree *tree = Object::cast_to<SceneTree>(p_signal.get_object());
+	if (!tree || tree != SceneTree::get_singleton()) {
+		return false;
+	}
+
+	MutexLock lock(mutex);
+	if (frame_await_tree != tree->get_instance_id()) {
+		// The singleton only changes once the previous tree was freed, along with its connection.
+		// Drop what was still waiting on it, as its one-shot connections would have been.
+		for (const Ref<GDScriptFunctionState> &state : frame_awaits[frame_awaits_queue]) {
+			state->_clear_stack();
+		}
+		frame_awaits[frame_awaits_queue].clear();
+		frame_await_tree = tree->get_instance_id();
+		tree->connect(SNAME("process_frame"), callable_mp(this, &GDScriptLanguage::_resume_frame_awaits));
+	}
+	frame_awaits[frame_awaits_queue].push_back(p_state);
+	return true;
+}
+
+void GDScriptLanguage::_resume_frame_awaits() {
+	LocalVector<Ref<GDScriptFunctionState>> *resuming = nullptr;
+	{
+		MutexLock lock(mutex);
+		if (frame_awaits_resuming || frame_awaits[frame_awaits_queue].is_empty()) {
+			// Also ignore the signal if a resumed function emits it again, the other queue is what it awaits for.
+			return;
+		}
+		frame_awaits_resuming = true;
+		// Functions awaiting again while resuming wait for the next frame, like a one-shot connection would.
+		resuming = &frame_awaits[frame_awaits_queue];
+		frame_awaits_queue ^= 1;
+	}
+
+	// All queued functions resume in the order they started awaiting, at the position of this
+	// single connection among the other `process_frame` listeners.
+	for (const Ref<GDScriptFunctionState> &state : *resuming) {
+		// If the script or instance went away, the state was dropped as a connection would have been.
+		if (state->is_valid(true)) {
+			state->resume();
+		}
+	}
+	resuming->clear();
+
+	MutexLock lock(mutex);
+	frame_awaits_resuming = false;
 }
 
 void GDScriptLanguage::profiling_start() {
@@ -2560,6 +2660,9 @@ String GDScriptLanguage::get_global_class_name(const String &p_path, String *r_b
 }
 
 thread_local GDScriptLanguage::CallStack GDScriptLanguage::_call_stack;
+#ifdef DEBUG_ENABLED
+thread_local uint64_t *GDScriptLanguage::opcode_counts = nullptr;
+#endif
 
 GDScriptLanguage::GDScriptLanguage() {
 	calls = 0;
@@ -2649,7 +2752,8 @@ Ref<GDScript> GDScriptLanguage::get_script_by_fully_qualified_name(const String
 
 Ref<Resource> ResourceFormatLoaderGDScript::load(const String &p_path, const String &p_original_path, Error *r_error, bool p_use_sub_threads, float *r_progress, CacheMode p_cache_mode) {
 	Error err;
-	Ref<GDScript> scr = GDScriptCache::get_full_script(p_path, err, "", p_cache_mode == CACHE_MODE_IGNORE);
+	// Use the original path so remapped scripts (such as exported binary tokens) share the cache entry of their source.
+	Ref<GDScript> scr = GDScriptCache::get_full_script(p_original_path, err, "", p_cache_mode == CACHE_MODE_IGNORE);
 
 	if (err && scr.is_valid()) {
 		// If !scr.is_valid(), the error was likely from scr->load_source_code(), which already generates an error.
@@ -2666,6 +2770,7 @@ Ref<Resource> ResourceFormatLoaderGDScript::load(const String &p_path, const Str
 
 void ResourceFormatLoaderGDScript::get_recognized_extensions(List<String> *p_extensions) const {
 	p_extensions->push_back("gd");
+	p_extensions->push_back("gdc");
 }
 
 bool ResourceFormatLoaderGDScript::handles_type(const String &p_type) const {
@@ -2674,7 +2779,7 @@ bool ResourceFormatLoaderGDScript::handles_type(const String &p_type) const {
 
 String ResourceFormatLoaderGDScript::get_resource_type(const String &p_path) const {
 	String el = p_path.get_extension().to_lower();
-	if (el == "gd") {
+	if (el == "gd" || el == "gdc") {
 		return "GDScript";
 	}
 	return "";
@@ -2684,14 +2789,19 @@ void ResourceFormatLoaderGDScript::get_dependencies(const String &p_path, List<S
 	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::READ);
 	ERR_FAIL_COND_MSG(file.is_null(), "Cannot open file '" + p_path + "'.");
 
-	String source = file->get_as_utf8_string();
-	if (source.is_empty()) {
-		return;
-	}
-
 	GDScriptParser parser;
-	if (OK != parser.parse(source, p_path, false)) {
-		return;
+	if (p_path.get_extension().to_lower() == "gdc") {
+		if (OK != parser.parse_binary(file->get_buffer(file->get_length()), p_path)) {
+			return;
+		}
+	} else {
+		String source = file->get_as_utf8_string();
+		if (source.is_empty()) {
+			return;
+		}
+		if (OK != parser.parse(source, p_path, false)) {
+			return;
+		}
 	}
 
 	for (const String &E : parser.get_dependencies()) {
@@ -61,6 +61,7 @@ public:
 class GDScript : public Script {
 	GDCLASS(GDScript, Script);
 	bool tool = false;
+	bool thread_safe = false;
 	bool valid = false;
 	bool reloading = false;
 
@@ -100,6 +101,9 @@ class GDScript : public Script {
 	Vector<Variant> static_variables;
 	HashMap<StringName, GDScriptFunction *> member_functions;
 	HashMap<StringName, MemberInfo> member_indices; //members are just indices to the instantiated script.
+	// Changes every time `member_indices` is rebuilt, so member access caches in the VM can't outlive a reload.
+	uint32_t member_layout_id = 0;
+	static SafeNumeric<uint32_t> last_member_layout_id;
 	HashMap<StringName, Ref<GDScript>> subclasses;
 	HashMap<StringName, MethodInfo> _signals;
 	Dictionary rpc_config;
@@ -140,6 +144,7 @@ class GDScript : public Script {
 	bool clearing = false;
 	//exported members
 	String source;
+	Vector<uint8_t> binary_tokens; // Pre-tokenized source of exported scripts, used instead of `source` when not empty.
 	String path;
 	StringName local_name; // Inner class identifier or `class_name`.
 	StringName global_name; // `class_name`.
@@ -186,6 +191,19 @@ protected:
 	static void _bind_methods();
 
 public:
+	// Member access inline cache entries, used by the VM for `OPCODE_GET_NAMED_CACHED` and `OPCODE_SET_NAMED_CACHED`:
+	// the member layout id in the upper 32 bits, then the type tag and the member index.
+	enum {
+		MEMBER_CACHE_INDEX_MASK = 0xFFFFFF,
+		MEMBER_CACHE_TYPE_SHIFT = 24,
+		MEMBER_CACHE_TYPE_ANY = 0, // Untyped, anything can be assigned directly.
+		MEMBER_CACHE_TYPE_CHECKED = 0xFF, // Assignments go through `GDScriptInstance::set()` to be validated.
+	};
+
+	// Returns the cache entry for accessing the member `p_name` directly, or 0 if it has to be accessed by name.
+	uint64_t get_member_cache_entry(const StringName &p_name) const;
+	_FORCE_INLINE_ uint32_t get_member_layout_id() const { return member_layout_id; }
+
 #ifdef DEBUG_ENABLED
 	static String debug_get_script_name(const Ref<Script> &p_script);
 #endif
@@ -221,6 +239,7 @@ public:
 	virtual void get_script_signal_list(List<MethodInfo> *r_signals) const override;
 
 	bool is_tool() const override { return tool; }
+	bool is_thread_safe() const override { return thread_safe; }
 	Ref<GDScript> get_base() const;
 
 	const HashMap<StringName, MemberInfo> &debug_get_member_indices() const { return member_indices; }
@@ -256,6 +275,8 @@ public:
 	virtual void set_path(const String &p_path, bool p_take_over = false) override;
 	String get_script_path() const;
 	Error load_source_code(const String &p_path);
+	void set_binary_tokens_source(const Vector<uint8_t> &p_binary_tokens);
+	const Vector<uint8_t> &get_binary_tokens_source() const;
 
 	bool get_property_default_value(const StringName &p_property, Variant &r_value) const override;
 
@@ -350,6 +371,7 @@ class GDScriptLanguage : public ScriptLanguage {
 	friend class GDScriptFunctionState;
 
 	static GDScriptLanguage *singleton;
+	static int optimization_level;
 
 	Variant *_global_array = nullptr;
 	Vector<Variant> global_array;
@@ -383,6 +405,11 @@ class GDScriptLanguage : public ScriptLanguage {
 	};
 
 	static thread_local CallStack _call_stack;
+
+#ifdef DEBUG_ENABLED
+	// Executed instructions per opcode on this thread, if counting was enabled.
+	static thread_local uint64_t *opcode_counts;
+#endif
 	int _debug_max_call_stack = 0;
 
 	void _add_global(const StringName &p_name, const Variant &p_value);
@@ -402,6 +429,15 @@ class GDScriptLanguage : public ScriptLanguage {
 
 	HashMap<String, ObjectID> orphan_subclasses;
 
+	// Functions awaiting `SceneTree.process_frame`, resumed from one persistent connection
+	// instead of connecting a bound callable for every `await`. Double buffered, so the
+	// queue being resumed is never copied and new awaits go to the other one.
+	LocalVector<Ref<GDScriptFunctionState>> frame_awaits[2];
+	uint32_t frame_awaits_queue = 0;
+	bool frame_awaits_resuming = false;
+	ObjectID frame_await_tree;
+	void _resume_frame_awaits();
+
 public:
 	int calls;
 
@@ -483,6 +519,18 @@ public:
 
 	_FORCE_INLINE_ static GDScriptLanguage *get_singleton() { return singleton; }
 
+	bool await_next_frame(const Signal &p_signal, const Ref<GDScriptFunctionState> &p_state);
+
+	// 0 compiles the AST as written, 1 (default) enables the compiler's optimization passes.
+	static void set_optimization_level(int p_level) { optimization_level = CLAMP(p_level, 0, 1); }
+	_FORCE_INLINE_ static int get_optimization_level() { return optimization_level; }
+
+#ifdef DEBUG_ENABLED
+	// Counts the instructions executed on the calling thread into an array of `GDScriptFunction::OPCODE_END + 1` elements, or stops counting if null.
+	static void set_opcode_counts(uint64_t *p_counts) { opcode_counts = p_counts; }
+	_FORCE_INLINE_ static uint64_t *get_opcode_counts() { return opcode_counts; }
+#endif
+
 	virtual String get_name() const override;
 
 	/* LANGUAGE FUNCTIONS */
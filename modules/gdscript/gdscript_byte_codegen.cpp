@@ -176,6 +176,8 @@ void GDScriptByteCodeGenerator::write_start(GDScript *p_script, const StringName
 	function->return_type = p_return_type;
 	function->rpc_config = p_rpc_config;
 	function->_argument_count = 0;
+
+	optimize = GDScriptLanguage::get_optimization_level() > 0;
 }
 
 GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
@@ -383,6 +385,17 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_methods_count = 0;
 	}
 
+	if (member_caches.size()) {
+		function->member_caches = memnew_arr(SafeNumeric<uint64_t>, member_caches.size());
+		function->_member_caches_count = member_caches.size();
+		for (int i = 0; i < member_caches.size(); i++) {
+			function->member_caches[i].set(member_caches[i]);
+		}
+	} else {
+		function->member_caches = nullptr;
+		function->_member_caches_count = 0;
+	}
+
 	if (lambdas_map.size()) {
 		function->lambdas.resize(lambdas_map.size());
 		function->_lambdas_ptr = function->lambdas.ptrw();
@@ -582,9 +595,97 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 	}
 }
 
+static GDScriptFunction::Opcode _get_typed_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+	if (p_left_type == Variant::INT && p_right_type == Variant::INT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_OPERATOR_ADD_INT;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_INT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_INT;
+			case Variant::OP_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_EQUAL_INT;
+			case Variant::OP_NOT_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_INT;
+			case Variant::OP_LESS:
+				return GDScriptFunction::OPCODE_OPERATOR_LESS_INT;
+			case Variant::OP_LESS_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_INT;
+			case Variant::OP_GREATER:
+				return GDScriptFunction::OPCODE_OPERATOR_GREATER_INT;
+			case Variant::OP_GREATER_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_INT;
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::FLOAT && p_right_type == Variant::FLOAT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_OPERATOR_ADD_FLOAT;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_FLOAT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_FLOAT;
+			case Variant::OP_DIVIDE:
+				return GDScriptFunction::OPCODE_OPERATOR_DIVIDE_FLOAT;
+			case Variant::OP_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_EQUAL_FLOAT;
+			case Variant::OP_NOT_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_FLOAT;
+			case Variant::OP_LESS:
+				return GDScriptFunction::OPCODE_OPERATOR_LESS_FLOAT;
+			case Variant::OP_LESS_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_FLOAT;
+			case Variant::OP_GREATER:
+				return GDScriptFunction::OPCODE_OPERATOR_GREATER_FLOAT;
+			case Variant::OP_GREATER_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT;
+			default:
+				break;
+		}
+	} else if ((p_left_type == Variant::VECTOR2 || p_left_type == Variant::VECTOR3) && p_right_type == p_left_type) {
+		bool is_vector2 = p_left_type == Variant::VECTOR2;
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return is_vector2 ? GDScriptFunction::OPCODE_OPERATOR_ADD_VECTOR2 : GDScriptFunction::OPCODE_OPERATOR_ADD_VECTOR3;
+			case Variant::OP_SUBTRACT:
+				return is_vector2 ? GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_VECTOR2 : GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_VECTOR3;
+			case Variant::OP_MULTIPLY:
+				return is_vector2 ? GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR2 : GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3;
+			default:
+				break;
+		}
+	} else if ((p_left_type == Variant::VECTOR2 || p_left_type == Variant::VECTOR3) && p_right_type == Variant::FLOAT) {
+		bool is_vector2 = p_left_type == Variant::VECTOR2;
+		switch (p_operator) {
+			case Variant::OP_MULTIPLY:
+				return is_vector2 ? GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT : GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT;
+			case Variant::OP_DIVIDE:
+				return is_vector2 ? GDScriptFunction::OPCODE_OPERATOR_DIVIDE_VECTOR2_FLOAT : GDScriptFunction::OPCODE_OPERATOR_DIVIDE_VECTOR3_FLOAT;
+			default:
+				break;
+		}
+	}
+	return GDScriptFunction::OPCODE_END; // No direct opcode, use the validated evaluator.
+}
+
 void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand) {
 	// Avoid validated evaluator for modulo and division when operands are int, since there's no check for division by zero.
 	if (HAS_BUILTIN_TYPE(p_left_operand) && HAS_BUILTIN_TYPE(p_right_operand) && ((p_operator != Variant::OP_DIVIDE && p_operator != Variant::OP_MODULE) || p_left_operand.type.builtin_type != Variant::INT || p_right_operand.type.builtin_type != Variant::INT)) {
+		// Common number and vector operations are done directly by the VM, without calling the evaluator.
+		// Those opcodes set the type of the target themselves, so no type adjust is needed.
+		GDScriptFunction::Opcode typed_opcode = _get_typed_operator_opcode(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+		if (typed_opcode != GDScriptFunction::OPCODE_END) {
+			last_operator_pos = opcodes.size();
+			last_operator_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+			append_opcode(typed_opcode);
+			append(p_left_operand);
+			append(p_right_operand);
+			append(p_target);
+			return;
+		}
+
 		if (p_target.mode == Address::TEMPORARY) {
 			Variant::Type result_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 			Variant::Type temp_type = temporaries[p_target.address].type;
@@ -813,6 +914,24 @@ void GDScriptByteCodeGenerator::write_get(const Address &p_target, const Address
 	append(p_target);
 }
 
+bool GDScriptByteCodeGenerator::_can_cache_member_access(const Address &p_base) const {
+	// Values of unknown type may be script instances, so they're worth caching as well.
+	return !p_base.type.has_type || p_base.type.kind == GDScriptDataType::GDSCRIPT || p_base.type.kind == GDScriptDataType::SCRIPT;
+}
+
+int GDScriptByteCodeGenerator::_add_member_cache(const Address &p_base, const StringName &p_name) {
+	uint64_t entry = 0;
+	// When the class is known and already has its members, the first access doesn't need to look up the name.
+	if (p_base.type.has_type && p_base.type.kind == GDScriptDataType::GDSCRIPT) {
+		const GDScript *base_script = Object::cast_to<GDScript>(p_base.type.script_type);
+		if (base_script && base_script->get_member_layout_id() != 0) {
+			entry = base_script->get_member_cache_entry(p_name);
+		}
+	}
+	member_caches.push_back(entry);
+	return member_caches.size() - 1;
+}
+
 void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
 	if (HAS_BUILTIN_TYPE(p_target) && Variant::get_member_validated_setter(p_target.type.builtin_type, p_name) &&
 			IS_BUILTIN_TYPE(p_source, Variant::get_member_type(p_target.type.builtin_type, p_name))) {
@@ -826,6 +945,14 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 #endif
 		return;
 	}
+	if (_can_cache_member_access(p_target)) {
+		append_opcode(GDScriptFunction::OPCODE_SET_NAMED_CACHED);
+		append(p_target);
+		append(p_source);
+		append(p_name);
+		append(_add_member_cache(p_target, p_name));
+		return;
+	}
 	append_opcode(GDScriptFunction::OPCODE_SET_NAMED);
 	append(p_target);
 	append(p_source);
@@ -844,6 +971,14 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 #endif
 		return;
 	}
+	if (_can_cache_member_access(p_source)) {
+		append_opcode(GDScriptFunction::OPCODE_GET_NAMED_CACHED);
+		append(p_source);
+		append(p_target);
+		append(p_name);
+		append(_add_member_cache(p_source, p_name));
+		return;
+	}
 	append_opcode(GDScriptFunction::OPCODE_GET_NAMED);
 	append(p_source);
 	append(p_target);
@@ -876,7 +1011,50 @@ void GDScriptByteCodeGenerator::write_get_static_variable(const Address &p_targe
 	append(p_index);
 }
 
+bool GDScriptByteCodeGenerator::forward_operator_result(const Address &p_target, const Address &p_source) {
+	// When the source was just computed by a direct operator into a temporary, make that operator
+	// write into the local instead, so the copy can be dropped.
+	if (!optimize || last_operator_pos < 0 || last_operator_pos + 4 != opcodes.size()) {
+		return false;
+	}
+	if (p_source.mode != Address::TEMPORARY || p_target.mode != Address::LOCAL_VARIABLE || !HAS_BUILTIN_TYPE(p_target) || p_target.type.builtin_type != last_operator_type) {
+		return false;
+	}
+
+	const int target_index = last_operator_pos + 3;
+	StackSlot &temp = temporaries.write[p_source.address];
+	if (temp.bytecode_indices.is_empty() || temp.bytecode_indices[temp.bytecode_indices.size() - 1] != target_index) {
+		return false;
+	}
+	temp.bytecode_indices.remove_at(temp.bytecode_indices.size() - 1);
+	opcodes.write[target_index] = address_of(p_target);
+	last_operator_pos = -1;
+	return true;
+}
+
+static GDScriptFunction::Opcode _get_typed_assign_opcode(Variant::Type p_type) {
+	// Only types stored inline in the Variant, so the value can be copied without reference counting.
+	switch (p_type) {
+		case Variant::BOOL:
+			return GDScriptFunction::OPCODE_ASSIGN_BOOL;
+		case Variant::INT:
+			return GDScriptFunction::OPCODE_ASSIGN_INT;
+		case Variant::FLOAT:
+			return GDScriptFunction::OPCODE_ASSIGN_FLOAT;
+		case Variant::VECTOR2:
+			return GDScriptFunction::OPCODE_ASSIGN_VECTOR2;
+		case Variant::VECTOR3:
+			return GDScriptFunction::OPCODE_ASSIGN_VECTOR3;
+		default:
+			return GDScriptFunction::OPCODE_END;
+	}
+}
+
 void GDScriptByteCodeGenerator::write_assign_with_conversion(const Address &p_target, const Address &p_source) {
+	if (forward_operator_result(p_target, p_source)) {
+		return;
+	}
+
 	switch (p_target.type.kind) {
 		case GDScriptDataType::BUILTIN: {
 			if (p_target.type.builtin_type == Variant::ARRAY && p_target.type.has_container_element_type()) {
@@ -887,6 +1065,11 @@ void GDScriptByteCodeGenerator::write_assign_with_conversion(const Address &p_ta
 				append(get_constant_pos(element_type.script_type) | (GDScriptFunction::ADDR_TYPE_CONSTANT << GDScriptFunction::ADDR_BITS));
 				append(element_type.builtin_type);
 				append(element_type.native_type);
+			} else if (IS_BUILTIN_TYPE(p_source, p_target.type.builtin_type) && _get_typed_assign_opcode(p_target.type.builtin_type) != GDScriptFunction::OPCODE_END) {
+				// Same type, no conversion or check needed.
+				append_opcode(_get_typed_assign_opcode(p_target.type.builtin_type));
+				append(p_target);
+				append(p_source);
 			} else {
 				append_opcode(GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN);
 				append(p_target);
@@ -925,6 +1108,10 @@ void GDScriptByteCodeGenerator::write_assign_with_conversion(const Address &p_ta
 }
 
 void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Address &p_source) {
+	if (forward_operator_result(p_target, p_source)) {
+		return;
+	}
+
 	if (p_target.type.kind == GDScriptDataType::BUILTIN && p_target.type.builtin_type == Variant::ARRAY && p_target.type.has_container_element_type()) {
 		const GDScriptDataType &element_type = p_target.type.get_container_element_type();
 		append_opcode(GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY);
@@ -939,6 +1126,10 @@ void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Addr
 		append(p_target);
 		append(p_source);
 		append(p_target.type.builtin_type);
+	} else if (HAS_BUILTIN_TYPE(p_target) && IS_BUILTIN_TYPE(p_source, p_target.type.builtin_type) && _get_typed_assign_opcode(p_target.type.builtin_type) != GDScriptFunction::OPCODE_END) {
+		append_opcode(_get_typed_assign_opcode(p_target.type.builtin_type));
+		append(p_target);
+		append(p_source);
 	} else {
 		append_opcode(GDScriptFunction::OPCODE_ASSIGN);
 		append(p_target);
@@ -1653,6 +1844,7 @@ void GDScriptByteCodeGenerator::write_endfor() {
 void GDScriptByteCodeGenerator::start_while_condition() {
 	current_breaks_to_patch.push_back(List<int>());
 	continue_addrs.push_back(opcodes.size());
+	last_operator_pos = -1; // Jump target.
 }
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
@@ -77,6 +77,11 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	bool ended = false;
 	GDScriptFunction *function = nullptr;
 	bool debug_stack = false;
+	bool optimize = false;
+
+	// Start of the last direct operator, if nothing was written after it. Used to forward its result.
+	int last_operator_pos = -1;
+	Variant::Type last_operator_type = Variant::NIL;
 
 	Vector<int> opcodes;
 	List<RBMap<StringName, int>> stack_id_stack;
@@ -121,6 +126,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	RBMap<GDScriptUtilityFunctions::FunctionPtr, int> gds_utilities_map;
 	RBMap<MethodBind *, int> method_bind_map;
 	RBMap<GDScriptFunction *, int> lambdas_map;
+	Vector<uint64_t> member_caches; // Initial entries, see GDScript::get_member_cache_entry().
 
 #if DEBUG_ENABLED
 	// Keep method and property names for pointer and validated operations.
@@ -452,8 +458,13 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		last_operator_pos = -1; // The next instruction is a jump target.
 	}
 
+	bool forward_operator_result(const Address &p_target, const Address &p_source);
+	bool _can_cache_member_access(const Address &p_base) const;
+	int _add_member_cache(const Address &p_base, const StringName &p_name);
+
 public:
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
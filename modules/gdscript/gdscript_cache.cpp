@@ -36,6 +36,8 @@
 #include "gdscript_parser.h"
 
 #include "core/io/file_access.h"
+#include "core/io/resource_loader.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/vector.h"
 #include "scene/resources/packed_scene.h"
 
@@ -67,10 +69,15 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 
 	while (p_new_status > status) {
 		switch (status) {
-			case EMPTY:
+			case EMPTY: {
 				status = PARSED;
-				result = parser->parse(GDScriptCache::get_source_code(path), path, false);
-				break;
+				String remapped_path = ResourceLoader::path_remap(path);
+				if (remapped_path.get_extension().to_lower() == "gdc") {
+					result = parser->parse_binary(GDScriptCache::get_binary_tokens(remapped_path), path);
+				} else {
+					result = parser->parse(GDScriptCache::get_source_code(path), path, false);
+				}
+			} break;
 			case PARSED: {
 				status = INHERITANCE_SOLVED;
 				Error inheritance_result = get_analyzer()->resolve_inheritance();
@@ -239,6 +246,13 @@ String GDScriptCache::get_source_code(const String &p_path) {
 	return source;
 }
 
+Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path) {
+	Error err;
+	Vector<uint8_t> buffer = FileAccess::get_file_as_bytes(p_path, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, Vector<uint8_t>(), "Failed to open binary GDScript file '" + p_path + "'.");
+	return buffer;
+}
+
 Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_error, const String &p_owner) {
 	MutexLock lock(singleton->mutex);
 	if (!p_owner.is_empty()) {
@@ -269,6 +283,86 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 	return script;
 }
 
+// Exported projects may only contain the remapped binary tokens (`.gdc`) and not the `.gd` file,
+// ResourceLoader::exists() follows the remap.
+bool GDScriptCache::script_file_exists(const String &p_path) {
+	return p_path.get_extension() == "gd" && ResourceLoader::exists(p_path, "GDScript");
+}
+
+void GDScriptCache::_parse_script_task(void *p_userdata) {
+	static_cast<GDScriptParserRef *>(p_userdata)->raise_status(GDScriptParserRef::PARSED);
+}
+
+// Parses the scripts the given one depends on, and theirs in turn, one level at a time on the worker threads,
+// so analyzing the script afterwards finds them in the parser map and only runs the analyzer on this thread.
+// Parsing doesn't touch the cache or other scripts, analysis does, which is why it stays serial.
+// The returned parsers have to be kept alive until the analysis is done.
+// Each script is its own task so a caller running on the pool, such as a threaded load, helps with the queue
+// while waiting instead of blocking a worker. Parsers only enter the map once parsed, since the tasks run
+// meanwhile may load scripts themselves.
+LocalVector<Ref<GDScriptParserRef>> GDScriptCache::_parse_dependencies(const Ref<GDScriptParserRef> &p_parser_ref) {
+	LocalVector<Ref<GDScriptParserRef>> parsed;
+
+	if (WorkerThreadPool::get_singleton()->get_thread_count() < 2) {
+		return parsed;
+	}
+
+	// Builds the shared builtin type table before the workers read it.
+	GDScriptParser::get_builtin_type(StringName());
+
+	HashSet<String> visited;
+	visited.insert(p_parser_ref->path);
+	List<String> pending = p_parser_ref->get_parser()->get_dependencies();
+
+	while (!pending.is_empty()) {
+		LocalVector<Ref<GDScriptParserRef>> batch;
+		for (const String &E : pending) {
+			if (visited.has(E)) {
+				continue;
+			}
+			visited.insert(E);
+			if (singleton->parser_map.has(E) || !script_file_exists(E)) {
+				continue;
+			}
+			Ref<GDScriptParserRef> ref;
+			ref.instantiate();
+			ref->parser = memnew(GDScriptParser);
+			ref->path = E;
+			batch.push_back(ref);
+		}
+		pending.clear();
+
+		if (batch.is_empty()) {
+			break;
+		}
+
+		LocalVector<WorkerThreadPool::TaskID> tasks;
+		for (const Ref<GDScriptParserRef> &E : batch) {
+			tasks.push_back(WorkerThreadPool::get_singleton()->add_native_task(&_parse_script_task, E.ptr(), true, SNAME("GDScriptParseDependencies")));
+		}
+		for (WorkerThreadPool::TaskID task : tasks) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+		}
+
+		for (const Ref<GDScriptParserRef> &E : batch) {
+			if (singleton->parser_map.has(E->path)) {
+				// Loaded by a task run while waiting, keep that one. Without a path this one won't unregister it.
+				E->path = String();
+				continue;
+			}
+			singleton->parser_map[E->path] = E.ptr();
+			if (E->result == OK) {
+				for (const String &F : E->get_parser()->get_dependencies()) {
+					pending.push_back(F);
+				}
+			}
+			parsed.push_back(E);
+		}
+	}
+
+	return parsed;
+}
+
 Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_error, const String &p_owner, bool p_update_from_disk) {
 	MutexLock lock(singleton->mutex);
 
@@ -285,11 +379,20 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 		}
 	}
 
+	LocalVector<Ref<GDScriptParserRef>> dependency_parsers;
 	if (script.is_null()) {
+		// Held so the shallow script reuses this parse.
+		Error parse_error = OK;
+		Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, parse_error);
+
 		script = get_shallow_script(p_path, r_error);
 		if (r_error) {
 			return script;
 		}
+
+		if (parse_error == OK) {
+			dependency_parsers = _parse_dependencies(parser_ref);
+		}
 	}
 
 	if (p_update_from_disk) {
@@ -37,6 +37,7 @@
 #include "core/os/mutex.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
 #include "scene/resources/packed_scene.h"
 
 class GDScriptAnalyzer;
@@ -94,11 +95,16 @@ class GDScriptCache {
 
 	Mutex mutex;
 
+	static void _parse_script_task(void *p_userdata);
+	static LocalVector<Ref<GDScriptParserRef>> _parse_dependencies(const Ref<GDScriptParserRef> &p_parser_ref);
+
 public:
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
 	static Ref<GDScriptParserRef> get_parser(const String &p_path, GDScriptParserRef::Status status, Error &r_error, const String &p_owner = String());
 	static String get_source_code(const String &p_path);
+	static Vector<uint8_t> get_binary_tokens(const String &p_path);
+	static bool script_file_exists(const String &p_path);
 	static Ref<GDScript> get_shallow_script(const String &p_path, Error &r_error, const String &p_owner = String());
 	static Ref<GDScript> get_full_script(const String &p_path, Error &r_error, const String &p_owner = String(), bool p_update_from_disk = false);
 	static Ref<GDScript> get_cached_script(const String &p_path);
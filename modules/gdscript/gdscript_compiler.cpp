@@ -1941,6 +1941,19 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 			} break;
 			case GDScriptParser::Node::IF: {
 				const GDScriptParser::IfNode *if_n = static_cast<const GDScriptParser::IfNode *>(s);
+
+				if (optimize && if_n->condition->is_constant) {
+					// The analyzer already reduced the condition, so only the branch that can run is compiled.
+					const GDScriptParser::SuiteNode *taken_block = if_n->condition->reduced_value.booleanize() ? if_n->true_block : if_n->false_block;
+					if (taken_block) {
+						err = _parse_block(codegen, taken_block);
+						if (err) {
+							return err;
+						}
+					}
+					break;
+				}
+
 				GDScriptCodeGenerator::Address condition = _parse_expression(codegen, err, if_n->condition);
 				if (err) {
 					return err;
@@ -2001,6 +2014,10 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 			case GDScriptParser::Node::WHILE: {
 				const GDScriptParser::WhileNode *while_n = static_cast<const GDScriptParser::WhileNode *>(s);
 
+				if (optimize && while_n->condition->is_constant && !while_n->condition->reduced_value.booleanize()) {
+					break; // The loop body can never run.
+				}
+
 				gen->start_while_condition();
 
 				GDScriptCodeGenerator::Address condition = _parse_expression(codegen, err, while_n->condition);
@@ -2149,6 +2166,10 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 		}
 
 		gen->clean_temporaries();
+
+		if (optimize && (s->type == GDScriptParser::Node::RETURN || s->type == GDScriptParser::Node::BREAK || s->type == GDScriptParser::Node::CONTINUE)) {
+			break; // The rest of the block is unreachable.
+		}
 	}
 
 	if (p_add_locals && p_reset_locals) {
@@ -2595,6 +2616,7 @@ Error GDScriptCompiler::_prepare_compilation(GDScript *p_script, const GDScriptP
 
 	p_script->member_functions.clear();
 	p_script->member_indices.clear();
+	p_script->member_layout_id = GDScript::last_member_layout_id.increment();
 	p_script->static_variables_indices.clear();
 	p_script->static_variables.clear();
 	p_script->_signals.clear();
@@ -2607,6 +2629,7 @@ Error GDScriptCompiler::_prepare_compilation(GDScript *p_script, const GDScriptP
 	p_script->clearing = false;
 
 	p_script->tool = parser->is_tool();
+	p_script->thread_safe = p_class->annotated_thread_safe;
 
 	if (p_script->local_name != StringName()) {
 		if (ClassDB::class_exists(p_script->local_name) && ClassDB::is_class_exposed(p_script->local_name)) {
@@ -3018,6 +3041,7 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 	error = "";
 	parser = p_parser;
 	main_script = p_script;
+	optimize = GDScriptLanguage::get_optimization_level() > 0;
 	const GDScriptParser::ClassNode *root = parser->get_tree();
 
 	source = p_script->get_path();
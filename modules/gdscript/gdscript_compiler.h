@@ -143,6 +143,7 @@ class GDScriptCompiler {
 	String error;
 	GDScriptParser::ExpressionNode *awaited_node = nullptr;
 	bool has_static_data = false;
+	bool optimize = true;
 
 public:
 	static void convert_to_initializer_type(Variant &p_variant, const GDScriptParser::VariableNode *p_node);
@@ -97,6 +97,233 @@ static String _disassemble_address(const GDScript *p_script, const GDScriptFunct
 	return "<err>";
 }
 
+static const char *opcode_names[] = {
+	"OPERATOR",
+	"OPERATOR_VALIDATED",
+	"OPERATOR_ADD_INT",
+	"OPERATOR_SUBTRACT_INT",
+	"OPERATOR_MULTIPLY_INT",
+	"OPERATOR_EQUAL_INT",
+	"OPERATOR_NOT_EQUAL_INT",
+	"OPERATOR_LESS_INT",
+	"OPERATOR_LESS_EQUAL_INT",
+	"OPERATOR_GREATER_INT",
+	"OPERATOR_GREATER_EQUAL_INT",
+	"OPERATOR_ADD_FLOAT",
+	"OPERATOR_SUBTRACT_FLOAT",
+	"OPERATOR_MULTIPLY_FLOAT",
+	"OPERATOR_DIVIDE_FLOAT",
+	"OPERATOR_EQUAL_FLOAT",
+	"OPERATOR_NOT_EQUAL_FLOAT",
+	"OPERATOR_LESS_FLOAT",
+	"OPERATOR_LESS_EQUAL_FLOAT",
+	"OPERATOR_GREATER_FLOAT",
+	"OPERATOR_GREATER_EQUAL_FLOAT",
+	"OPERATOR_ADD_VECTOR2",
+	"OPERATOR_SUBTRACT_VECTOR2",
+	"OPERATOR_MULTIPLY_VECTOR2",
+	"OPERATOR_MULTIPLY_VECTOR2_FLOAT",
+	"OPERATOR_DIVIDE_VECTOR2_FLOAT",
+	"OPERATOR_ADD_VECTOR3",
+	"OPERATOR_SUBTRACT_VECTOR3",
+	"OPERATOR_MULTIPLY_VECTOR3",
+	"OPERATOR_MULTIPLY_VECTOR3_FLOAT",
+	"OPERATOR_DIVIDE_VECTOR3_FLOAT",
+	"TYPE_TEST_BUILTIN",
+	"TYPE_TEST_ARRAY",
+	"TYPE_TEST_NATIVE",
+	"TYPE_TEST_SCRIPT",
+	"SET_KEYED",
+	"SET_KEYED_VALIDATED",
+	"SET_INDEXED_VALIDATED",
+	"GET_KEYED",
+	"GET_KEYED_VALIDATED",
+	"GET_INDEXED_VALIDATED",
+	"SET_NAMED",
+	"SET_NAMED_VALIDATED",
+	"SET_NAMED_CACHED",
+	"GET_NAMED",
+	"GET_NAMED_VALIDATED",
+	"GET_NAMED_CACHED",
+	"SET_MEMBER",
+	"GET_MEMBER",
+	"SET_STATIC_VARIABLE",
+	"GET_STATIC_VARIABLE",
+	"ASSIGN",
+	"ASSIGN_TRUE",
+	"ASSIGN_FALSE",
+	"ASSIGN_BOOL",
+	"ASSIGN_INT",
+	"ASSIGN_FLOAT",
+	"ASSIGN_VECTOR2",
+	"ASSIGN_VECTOR3",
+	"ASSIGN_TYPED_BUILTIN",
+	"ASSIGN_TYPED_ARRAY",
+	"ASSIGN_TYPED_NATIVE",
+	"ASSIGN_TYPED_SCRIPT",
+	"CAST_TO_BUILTIN",
+	"CAST_TO_NATIVE",
+	"CAST_TO_SCRIPT",
+	"CONSTRUCT",
+	"CONSTRUCT_VALIDATED",
+	"CONSTRUCT_ARRAY",
+	"CONSTRUCT_TYPED_ARRAY",
+	"CONSTRUCT_DICTIONARY",
+	"CALL",
+	"CALL_RETURN",
+	"CALL_ASYNC",
+	"CALL_UTILITY",
+	"CALL_UTILITY_VALIDATED",
+	"CALL_GDSCRIPT_UTILITY",
+	"CALL_BUILTIN_TYPE_VALIDATED",
+	"CALL_SELF_BASE",
+	"CALL_METHOD_BIND",
+	"CALL_METHOD_BIND_RET",
+	"CALL_BUILTIN_STATIC",
+	"CALL_NATIVE_STATIC",
+	"CALL_PTRCALL_NO_RETURN",
+	"CALL_PTRCALL_BOOL",
+	"CALL_PTRCALL_INT",
+	"CALL_PTRCALL_FLOAT",
+	"CALL_PTRCALL_STRING",
+	"CALL_PTRCALL_VECTOR2",
+	"CALL_PTRCALL_VECTOR2I",
+	"CALL_PTRCALL_RECT2",
+	"CALL_PTRCALL_RECT2I",
+	"CALL_PTRCALL_VECTOR3",
+	"CALL_PTRCALL_VECTOR3I",
+	"CALL_PTRCALL_TRANSFORM2D",
+	"CALL_PTRCALL_VECTOR4",
+	"CALL_PTRCALL_VECTOR4I",
+	"CALL_PTRCALL_PLANE",
+	"CALL_PTRCALL_QUATERNION",
+	"CALL_PTRCALL_AABB",
+	"CALL_PTRCALL_BASIS",
+	"CALL_PTRCALL_TRANSFORM3D",
+	"CALL_PTRCALL_PROJECTION",
+	"CALL_PTRCALL_COLOR",
+	"CALL_PTRCALL_STRING_NAME",
+	"CALL_PTRCALL_NODE_PATH",
+	"CALL_PTRCALL_RID",
+	"CALL_PTRCALL_OBJECT",
+	"CALL_PTRCALL_CALLABLE",
+	"CALL_PTRCALL_SIGNAL",
+	"CALL_PTRCALL_DICTIONARY",
+	"CALL_PTRCALL_ARRAY",
+	"CALL_PTRCALL_PACKED_BYTE_ARRAY",
+	"CALL_PTRCALL_PACKED_INT32_ARRAY",
+	"CALL_PTRCALL_PACKED_INT64_ARRAY",
+	"CALL_PTRCALL_PACKED_FLOAT32_ARRAY",
+	"CALL_PTRCALL_PACKED_FLOAT64_ARRAY",
+	"CALL_PTRCALL_PACKED_STRING_ARRAY",
+	"CALL_PTRCALL_PACKED_VECTOR2_ARRAY",
+	"CALL_PTRCALL_PACKED_VECTOR3_ARRAY",
+	"CALL_PTRCALL_PACKED_COLOR_ARRAY",
+	"AWAIT",
+	"AWAIT_RESUME",
+	"CREATE_LAMBDA",
+	"CREATE_SELF_LAMBDA",
+	"JUMP",
+	"JUMP_IF",
+	"JUMP_IF_NOT",
+	"JUMP_TO_DEF_ARGUMENT",
+	"JUMP_IF_SHARED",
+	"RETURN",
+	"RETURN_TYPED_BUILTIN",
+	"RETURN_TYPED_ARRAY",
+	"RETURN_TYPED_NATIVE",
+	"RETURN_TYPED_SCRIPT",
+	"ITERATE_BEGIN",
+	"ITERATE_BEGIN_INT",
+	"ITERATE_BEGIN_FLOAT",
+	"ITERATE_BEGIN_VECTOR2",
+	"ITERATE_BEGIN_VECTOR2I",
+	"ITERATE_BEGIN_VECTOR3",
+	"ITERATE_BEGIN_VECTOR3I",
+	"ITERATE_BEGIN_STRING",
+	"ITERATE_BEGIN_DICTIONARY",
+	"ITERATE_BEGIN_ARRAY",
+	"ITERATE_BEGIN_PACKED_BYTE_ARRAY",
+	"ITERATE_BEGIN_PACKED_INT32_ARRAY",
+	"ITERATE_BEGIN_PACKED_INT64_ARRAY",
+	"ITERATE_BEGIN_PACKED_FLOAT32_ARRAY",
+	"ITERATE_BEGIN_PACKED_FLOAT64_ARRAY",
+	"ITERATE_BEGIN_PACKED_STRING_ARRAY",
+	"ITERATE_BEGIN_PACKED_VECTOR2_ARRAY",
+	"ITERATE_BEGIN_PACKED_VECTOR3_ARRAY",
+	"ITERATE_BEGIN_PACKED_COLOR_ARRAY",
+	"ITERATE_BEGIN_OBJECT",
+	"ITERATE",
+	"ITERATE_INT",
+	"ITERATE_FLOAT",
+	"ITERATE_VECTOR2",
+	"ITERATE_VECTOR2I",
+	"ITERATE_VECTOR3",
+	"ITERATE_VECTOR3I",
+	"ITERATE_STRING",
+	"ITERATE_DICTIONARY",
+	"ITERATE_ARRAY",
+	"ITERATE_PACKED_BYTE_ARRAY",
+	"ITERATE_PACKED_INT32_ARRAY",
+	"ITERATE_PACKED_INT64_ARRAY",
+	"ITERATE_PACKED_FLOAT32_ARRAY",
+	"ITERATE_PACKED_FLOAT64_ARRAY",
+	"ITERATE_PACKED_STRING_ARRAY",
+	"ITERATE_PACKED_VECTOR2_ARRAY",
+	"ITERATE_PACKED_VECTOR3_ARRAY",
+	"ITERATE_PACKED_COLOR_ARRAY",
+	"ITERATE_OBJECT",
+	"STORE_GLOBAL",
+	"STORE_NAMED_GLOBAL",
+	"TYPE_ADJUST_BOOL",
+	"TYPE_ADJUST_INT",
+	"TYPE_ADJUST_FLOAT",
+	"TYPE_ADJUST_STRING",
+	"TYPE_ADJUST_VECTOR2",
+	"TYPE_ADJUST_VECTOR2I",
+	"TYPE_ADJUST_RECT2",
+	"TYPE_ADJUST_RECT2I",
+	"TYPE_ADJUST_VECTOR3",
+	"TYPE_ADJUST_VECTOR3I",
+	"TYPE_ADJUST_TRANSFORM2D",
+	"TYPE_ADJUST_VECTOR4",
+	"TYPE_ADJUST_VECTOR4I",
+	"TYPE_ADJUST_PLANE",
+	"TYPE_ADJUST_QUATERNION",
+	"TYPE_ADJUST_AABB",
+	"TYPE_ADJUST_BASIS",
+	"TYPE_ADJUST_TRANSFORM3D",
+	"TYPE_ADJUST_PROJECTION",
+	"TYPE_ADJUST_COLOR",
+	"TYPE_ADJUST_STRING_NAME",
+	"TYPE_ADJUST_NODE_PATH",
+	"TYPE_ADJUST_RID",
+	"TYPE_ADJUST_OBJECT",
+	"TYPE_ADJUST_CALLABLE",
+	"TYPE_ADJUST_SIGNAL",
+	"TYPE_ADJUST_DICTIONARY",
+	"TYPE_ADJUST_ARRAY",
+	"TYPE_ADJUST_PACKED_BYTE_ARRAY",
+	"TYPE_ADJUST_PACKED_INT32_ARRAY",
+	"TYPE_ADJUST_PACKED_INT64_ARRAY",
+	"TYPE_ADJUST_PACKED_FLOAT32_ARRAY",
+	"TYPE_ADJUST_PACKED_FLOAT64_ARRAY",
+	"TYPE_ADJUST_PACKED_STRING_ARRAY",
+	"TYPE_ADJUST_PACKED_VECTOR2_ARRAY",
+	"TYPE_ADJUST_PACKED_VECTOR3_ARRAY",
+	"TYPE_ADJUST_PACKED_COLOR_ARRAY",
+	"ASSERT",
+	"BREAKPOINT",
+	"LINE",
+	"END",
+};
+static_assert(sizeof(opcode_names) / sizeof(opcode_names[0]) == GDScriptFunction::OPCODE_END + 1, "Opcode names aren't the same as opcodes in enum.");
+
+const char *GDScriptFunction::get_opcode_name(Opcode p_opcode) {
+	ERR_FAIL_INDEX_V(p_opcode, OPCODE_END + 1, "");
+	return opcode_names[p_opcode];
+}
+
 void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 #define DADDR(m_ip) (_disassemble_address(_script, *this, _code_ptr[ip + m_ip]))
 
@@ -141,6 +368,49 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+
+#define DISASSEMBLE_OPERATOR_TYPED(m_op, m_v_type, m_operator) \
+	case OPCODE_OPERATOR_##m_op##_##m_v_type: {                \
+		text += "operator (typed ";                            \
+		text += #m_v_type;                                     \
+		text += ") ";                                          \
+		text += DADDR(3);                                      \
+		text += " = ";                                         \
+		text += DADDR(1);                                      \
+		text += " " m_operator " ";                            \
+		text += DADDR(2);                                      \
+		incr += 4;                                             \
+	} break
+
+				DISASSEMBLE_OPERATOR_TYPED(ADD, INT, "+");
+				DISASSEMBLE_OPERATOR_TYPED(SUBTRACT, INT, "-");
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY, INT, "*");
+				DISASSEMBLE_OPERATOR_TYPED(EQUAL, INT, "==");
+				DISASSEMBLE_OPERATOR_TYPED(NOT_EQUAL, INT, "!=");
+				DISASSEMBLE_OPERATOR_TYPED(LESS, INT, "<");
+				DISASSEMBLE_OPERATOR_TYPED(LESS_EQUAL, INT, "<=");
+				DISASSEMBLE_OPERATOR_TYPED(GREATER, INT, ">");
+				DISASSEMBLE_OPERATOR_TYPED(GREATER_EQUAL, INT, ">=");
+				DISASSEMBLE_OPERATOR_TYPED(ADD, FLOAT, "+");
+				DISASSEMBLE_OPERATOR_TYPED(SUBTRACT, FLOAT, "-");
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY, FLOAT, "*");
+				DISASSEMBLE_OPERATOR_TYPED(DIVIDE, FLOAT, "/");
+				DISASSEMBLE_OPERATOR_TYPED(EQUAL, FLOAT, "==");
+				DISASSEMBLE_OPERATOR_TYPED(NOT_EQUAL, FLOAT, "!=");
+				DISASSEMBLE_OPERATOR_TYPED(LESS, FLOAT, "<");
+				DISASSEMBLE_OPERATOR_TYPED(LESS_EQUAL, FLOAT, "<=");
+				DISASSEMBLE_OPERATOR_TYPED(GREATER, FLOAT, ">");
+				DISASSEMBLE_OPERATOR_TYPED(GREATER_EQUAL, FLOAT, ">=");
+				DISASSEMBLE_OPERATOR_TYPED(ADD, VECTOR2, "+");
+				DISASSEMBLE_OPERATOR_TYPED(SUBTRACT, VECTOR2, "-");
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY, VECTOR2, "*");
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY, VECTOR2_FLOAT, "*");
+				DISASSEMBLE_OPERATOR_TYPED(DIVIDE, VECTOR2_FLOAT, "/");
+				DISASSEMBLE_OPERATOR_TYPED(ADD, VECTOR3, "+");
+				DISASSEMBLE_OPERATOR_TYPED(SUBTRACT, VECTOR3, "-");
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY, VECTOR3, "*");
+				DISASSEMBLE_OPERATOR_TYPED(MULTIPLY, VECTOR3_FLOAT, "*");
+				DISASSEMBLE_OPERATOR_TYPED(DIVIDE, VECTOR3_FLOAT, "/");
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -279,6 +549,16 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 4;
 			} break;
+			case OPCODE_SET_NAMED_CACHED: {
+				text += "set_named cached ";
+				text += DADDR(1);
+				text += "[\"";
+				text += _global_names_ptr[_code_ptr[ip + 3]];
+				text += "\"] = ";
+				text += DADDR(2);
+
+				incr += 5;
+			} break;
 			case OPCODE_GET_NAMED: {
 				text += "get_named ";
 				text += DADDR(2);
@@ -301,6 +581,17 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 4;
 			} break;
+			case OPCODE_GET_NAMED_CACHED: {
+				text += "get_named cached ";
+				text += DADDR(2);
+				text += " = ";
+				text += DADDR(1);
+				text += "[\"";
+				text += _global_names_ptr[_code_ptr[ip + 3]];
+				text += "\"]";
+
+				incr += 5;
+			} break;
 			case OPCODE_SET_MEMBER: {
 				text += "set_member ";
 				text += "[\"";
@@ -374,6 +665,23 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 2;
 			} break;
+
+#define DISASSEMBLE_ASSIGN_INLINE(m_v_type) \
+	case OPCODE_ASSIGN_##m_v_type: {        \
+		text += "assign (";                 \
+		text += #m_v_type;                  \
+		text += ") ";                       \
+		text += DADDR(1);                   \
+		text += " = ";                      \
+		text += DADDR(2);                   \
+		incr += 3;                          \
+	} break
+
+				DISASSEMBLE_ASSIGN_INLINE(BOOL);
+				DISASSEMBLE_ASSIGN_INLINE(INT);
+				DISASSEMBLE_ASSIGN_INLINE(FLOAT);
+				DISASSEMBLE_ASSIGN_INLINE(VECTOR2);
+				DISASSEMBLE_ASSIGN_INLINE(VECTOR3);
 			case OPCODE_ASSIGN_TYPED_BUILTIN: {
 				text += "assign typed builtin (";
 				text += Variant::get_type_name((Variant::Type)_code_ptr[ip + 3]);
@@ -121,6 +121,10 @@ GDScriptFunction::~GDScriptFunction() {
 		memdelete(lambdas[i]);
 	}
 
+	if (member_caches) {
+		memdelete_arr(member_caches);
+	}
+
 	for (int i = 0; i < argument_types.size(); i++) {
 		argument_types.write[i].script_type_ref = Ref<Script>();
 	}
@@ -134,6 +138,54 @@ GDScriptFunction::~GDScriptFunction() {
 
 /////////////////////
 
+SpinLock GDScriptFunctionState::stack_pool_lock;
+LocalVector<uint8_t *> GDScriptFunctionState::stack_pool[GDScriptFunctionState::STACK_POOL_CLASSES];
+
+uint8_t *GDScriptFunctionState::_alloc_stack(uint32_t p_size) {
+	const uint32_t shift = MAX(nearest_shift(p_size - 1), (unsigned int)STACK_POOL_MIN_SHIFT);
+	const uint32_t pool_class = shift - STACK_POOL_MIN_SHIFT;
+	if (pool_class >= STACK_POOL_CLASSES) {
+		return (uint8_t *)memalloc(p_size);
+	}
+
+	uint8_t *stack = nullptr;
+	stack_pool_lock.lock();
+	LocalVector<uint8_t *> &pool = stack_pool[pool_class];
+	if (!pool.is_empty()) {
+		stack = pool[pool.size() - 1];
+		pool.resize(pool.size() - 1);
+	}
+	stack_pool_lock.unlock();
+
+	return stack ? stack : (uint8_t *)memalloc(1 << shift);
+}
+
+void GDScriptFunctionState::_free_stack(uint8_t *p_stack, uint32_t p_size) {
+	const uint32_t pool_class = MAX(nearest_shift(p_size - 1), (unsigned int)STACK_POOL_MIN_SHIFT) - STACK_POOL_MIN_SHIFT;
+	if (pool_class < STACK_POOL_CLASSES) {
+		stack_pool_lock.lock();
+		LocalVector<uint8_t *> &pool = stack_pool[pool_class];
+		if (pool.size() < STACK_POOL_MAX_CACHED) {
+			pool.push_back(p_stack);
+			stack_pool_lock.unlock();
+			return;
+		}
+		stack_pool_lock.unlock();
+	}
+	memfree(p_stack);
+}
+
+void GDScriptFunctionState::clear_stack_pool() {
+	stack_pool_lock.lock();
+	for (int i = 0; i < STACK_POOL_CLASSES; i++) {
+		for (uint8_t *stack : stack_pool[i]) {
+			memfree(stack);
+		}
+		stack_pool[i].reset();
+	}
+	stack_pool_lock.unlock();
+}
+
 Variant GDScriptFunctionState::_signal_callback(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
 	Variant arg;
 	r_error.error = Callable::CallError::CALL_OK;
@@ -251,7 +303,7 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 
 void GDScriptFunctionState::_clear_stack() {
 	if (state.stack_size) {
-		Variant *stack = (Variant *)state.stack.ptr();
+		Variant *stack = (Variant *)state.stack;
 		// The first 3 are special addresses and not copied to the state, so we skip them here.
 		for (int i = 3; i < state.stack_size; i++) {
 			stack[i].~Variant();
@@ -288,4 +340,8 @@ GDScriptFunctionState::~GDScriptFunctionState() {
 		scripts_list.remove_from_list();
 		instances_list.remove_from_list();
 	}
+
+	if (state.stack) {
+		_free_stack(state.stack, state.alloca_size);
+	}
 }
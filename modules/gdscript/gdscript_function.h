@@ -35,8 +35,10 @@
 
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/spin_lock.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
@@ -196,6 +198,36 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		// Direct arithmetic and comparisons for operands statically typed as int or float.
+		OPCODE_OPERATOR_ADD_INT,
+		OPCODE_OPERATOR_SUBTRACT_INT,
+		OPCODE_OPERATOR_MULTIPLY_INT,
+		OPCODE_OPERATOR_EQUAL_INT,
+		OPCODE_OPERATOR_NOT_EQUAL_INT,
+		OPCODE_OPERATOR_LESS_INT,
+		OPCODE_OPERATOR_LESS_EQUAL_INT,
+		OPCODE_OPERATOR_GREATER_INT,
+		OPCODE_OPERATOR_GREATER_EQUAL_INT,
+		OPCODE_OPERATOR_ADD_FLOAT,
+		OPCODE_OPERATOR_SUBTRACT_FLOAT,
+		OPCODE_OPERATOR_MULTIPLY_FLOAT,
+		OPCODE_OPERATOR_DIVIDE_FLOAT,
+		OPCODE_OPERATOR_EQUAL_FLOAT,
+		OPCODE_OPERATOR_NOT_EQUAL_FLOAT,
+		OPCODE_OPERATOR_LESS_FLOAT,
+		OPCODE_OPERATOR_LESS_EQUAL_FLOAT,
+		OPCODE_OPERATOR_GREATER_FLOAT,
+		OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,
+		OPCODE_OPERATOR_ADD_VECTOR2,
+		OPCODE_OPERATOR_SUBTRACT_VECTOR2,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR2,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT,
+		OPCODE_OPERATOR_DIVIDE_VECTOR2_FLOAT,
+		OPCODE_OPERATOR_ADD_VECTOR3,
+		OPCODE_OPERATOR_SUBTRACT_VECTOR3,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR3,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT,
+		OPCODE_OPERATOR_DIVIDE_VECTOR3_FLOAT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_NATIVE,
@@ -208,8 +240,10 @@ public:
 		OPCODE_GET_INDEXED_VALIDATED,
 		OPCODE_SET_NAMED,
 		OPCODE_SET_NAMED_VALIDATED,
+		OPCODE_SET_NAMED_CACHED,
 		OPCODE_GET_NAMED,
 		OPCODE_GET_NAMED_VALIDATED,
+		OPCODE_GET_NAMED_CACHED,
 		OPCODE_SET_MEMBER,
 		OPCODE_GET_MEMBER,
 		OPCODE_SET_STATIC_VARIABLE, // Only for GDScript.
@@ -217,6 +251,12 @@ public:
 		OPCODE_ASSIGN,
 		OPCODE_ASSIGN_TRUE,
 		OPCODE_ASSIGN_FALSE,
+		// Copies between values of the same inline type.
+		OPCODE_ASSIGN_BOOL,
+		OPCODE_ASSIGN_INT,
+		OPCODE_ASSIGN_FLOAT,
+		OPCODE_ASSIGN_VECTOR2,
+		OPCODE_ASSIGN_VECTOR3,
 		OPCODE_ASSIGN_TYPED_BUILTIN,
 		OPCODE_ASSIGN_TYPED_ARRAY,
 		OPCODE_ASSIGN_TYPED_NATIVE,
@@ -449,6 +489,7 @@ private:
 	Vector<GDScriptUtilityFunctions::FunctionPtr> gds_utilities;
 	Vector<MethodBind *> methods;
 	Vector<GDScriptFunction *> lambdas;
+	SafeNumeric<uint64_t> *member_caches = nullptr; // See GDScript::get_member_cache_entry().
 
 	int _code_size = 0;
 	int _default_arg_count = 0;
@@ -467,6 +508,7 @@ private:
 	int _gds_utilities_count = 0;
 	int _methods_count = 0;
 	int _lambdas_count = 0;
+	int _member_caches_count = 0;
 
 	int *_code_ptr = nullptr;
 	const int *_default_arg_ptr = nullptr;
@@ -525,7 +567,7 @@ public:
 		StringName function_name;
 		String script_path;
 #endif
-		Vector<uint8_t> stack;
+		uint8_t *stack = nullptr; // Taken from the GDScriptFunctionState stack pool, `alloca_size` bytes.
 		int stack_size = 0;
 		uint32_t alloca_size = 0;
 		int ip = 0;
@@ -549,6 +591,7 @@ public:
 	void debug_get_stack_member_state(int p_line, List<Pair<StringName, int>> *r_stackvars) const;
 
 #ifdef DEBUG_ENABLED
+	static const char *get_opcode_name(Opcode p_opcode);
 	void disassemble(const Vector<String> &p_code_lines) const;
 #endif
 
@@ -567,6 +610,18 @@ class GDScriptFunctionState : public RefCounted {
 	SelfList<GDScriptFunctionState> scripts_list;
 	SelfList<GDScriptFunctionState> instances_list;
 
+	// Saved stacks are recycled by power of two size, so an `await` in a hot loop doesn't hit the allocator.
+	enum {
+		STACK_POOL_MIN_SHIFT = 8,
+		STACK_POOL_CLASSES = 8,
+		STACK_POOL_MAX_CACHED = 64,
+	};
+	static SpinLock stack_pool_lock;
+	static LocalVector<uint8_t *> stack_pool[STACK_POOL_CLASSES];
+
+	static uint8_t *_alloc_stack(uint32_t p_size);
+	static void _free_stack(uint8_t *p_stack, uint32_t p_size);
+
 protected:
 	static void _bind_methods();
 
@@ -577,6 +632,8 @@ public:
 	void _clear_stack();
 	void _clear_connections();
 
+	static void clear_stack_pool();
+
 	GDScriptFunctionState();
 	~GDScriptFunctionState();
 };
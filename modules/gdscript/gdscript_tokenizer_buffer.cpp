@@ -0,0 +1,418 @@
+/**************************************************************************/
+/*  gdscript_tokenizer_buffer.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_tokenizer_buffer.h"
+
+#include "core/io/compression.h"
+#include "core/io/marshalls.h"
+
+static void _append_uint32(Vector<uint8_t> &r_buffer, uint32_t p_value) {
+	int pos = r_buffer.size();
+	r_buffer.resize(pos + 4);
+	encode_uint32(p_value, &r_buffer.write[pos]);
+}
+
+static int _get_indent_flags(const String &p_line) {
+	if (p_line.is_empty() || (p_line[0] != ' ' && p_line[0] != '\t')) {
+		return 0;
+	}
+
+	int flags = p_line[0] == '\t' ? GDScriptTokenizerBuffer::INDENT_TABS : GDScriptTokenizerBuffer::INDENT_SPACES;
+	for (int i = 1; i < p_line.length() && (p_line[i] == ' ' || p_line[i] == '\t'); i++) {
+		if (p_line[i] != p_line[0]) {
+			flags |= GDScriptTokenizerBuffer::INDENT_MIXED;
+			break;
+		}
+	}
+	return flags;
+}
+
+static String _get_indent_char_name(int p_flags) {
+	return (p_flags & GDScriptTokenizerBuffer::INDENT_TABS) ? "tab" : "space";
+}
+
+bool GDScriptTokenizerBuffer::is_token_buffer(const Vector<uint8_t> &p_buffer) {
+	return p_buffer.size() >= HEADER_SIZE && p_buffer[0] == 'G' && p_buffer[1] == 'D' && p_buffer[2] == 'S' && p_buffer[3] == 'C';
+}
+
+Vector<uint8_t> GDScriptTokenizerBuffer::parse_code_string(const String &p_code, CompressMode p_compress_mode) {
+	HashMap<StringName, uint32_t> identifier_map;
+	HashMap<Variant, uint32_t, VariantHasher, VariantComparator> constant_map;
+	Vector<StringName> identifier_list;
+	Vector<Variant> constant_list;
+	Vector<uint32_t> token_list;
+	Vector<uint32_t> line_list; // Token index, line, column and indentation flags of every token that starts a line.
+	Vector<uint32_t> end_line_list; // Token index and end line of every token that spans several lines.
+	const Vector<String> source_lines = p_code.split("\n");
+
+	GDScriptTokenizerText tokenizer;
+	tokenizer.set_source_code(p_code);
+	tokenizer.set_multiline_mode(true); // Ignore whitespace tokens, they are rebuilt when loading.
+
+	int last_token_line = 0;
+	Token token = tokenizer.scan();
+	while (token.type != Token::TK_EOF) {
+		if (token.type == Token::ERROR) {
+			// Keep the script as text so the error is reported with full context when it's loaded.
+			return Vector<uint8_t>();
+		}
+
+		uint32_t payload = 0;
+		if (token.type == Token::LITERAL) {
+			if (!constant_map.has(token.literal)) {
+				constant_map[token.literal] = constant_list.size();
+				constant_list.push_back(token.literal);
+			}
+			payload = constant_map[token.literal];
+		} else if (token.type == Token::ANNOTATION || token.is_node_name()) {
+			StringName identifier = token.source;
+			if (!identifier_map.has(identifier)) {
+				identifier_map[identifier] = identifier_list.size();
+				identifier_list.push_back(identifier);
+			}
+			payload = identifier_map[identifier];
+		}
+
+		if (token_list.is_empty() || (token.start_line > last_token_line && !tokenizer.get_continuation_lines().has(last_token_line))) {
+			line_list.push_back(token_list.size());
+			line_list.push_back(token.start_line);
+			line_list.push_back(token.start_column);
+			line_list.push_back(token.start_line <= source_lines.size() ? _get_indent_flags(source_lines[token.start_line - 1]) : 0);
+		}
+		if (token.end_line != token.start_line) {
+			end_line_list.push_back(token_list.size());
+			end_line_list.push_back(token.end_line);
+		}
+		last_token_line = token.end_line;
+
+		token_list.push_back(uint32_t(token.type) | (payload << TOKEN_BITS));
+		token = tokenizer.scan();
+	}
+
+	Vector<uint8_t> body;
+	_append_uint32(body, identifier_list.size());
+	_append_uint32(body, constant_list.size());
+	_append_uint32(body, line_list.size() / 4);
+	_append_uint32(body, end_line_list.size() / 2);
+	_append_uint32(body, token_list.size());
+
+	for (const StringName &identifier : identifier_list) {
+		CharString utf8 = String(identifier).utf8();
+		_append_uint32(body, utf8.length());
+		int pos = body.size();
+		body.resize(pos + utf8.length());
+		memcpy(&body.write[pos], utf8.get_data(), utf8.length());
+	}
+
+	for (const Variant &constant : constant_list) {
+		int len = 0;
+		Error err = encode_variant(constant, nullptr, len);
+		ERR_FAIL_COND_V_MSG(err != OK, Vector<uint8_t>(), "Error when trying to encode a GDScript constant.");
+		_append_uint32(body, len);
+		int pos = body.size();
+		body.resize(pos + len);
+		encode_variant(constant, &body.write[pos], len);
+	}
+
+	for (uint32_t value : line_list) {
+		_append_uint32(body, value);
+	}
+	for (uint32_t value : end_line_list) {
+		_append_uint32(body, value);
+	}
+	for (uint32_t value : token_list) {
+		_append_uint32(body, value);
+	}
+
+	Vector<uint8_t> buffer;
+	buffer.resize(HEADER_SIZE);
+	uint8_t *header = buffer.ptrw();
+	header[0] = 'G';
+	header[1] = 'D';
+	header[2] = 'S';
+	header[3] = 'C';
+	encode_uint32(TOKENIZER_VERSION, &header[4]);
+
+	if (p_compress_mode == COMPRESS_ZSTD) {
+		encode_uint32(body.size(), &header[8]);
+		buffer.resize(HEADER_SIZE + Compression::get_max_compressed_buffer_size(body.size(), Compression::MODE_ZSTD));
+		int compressed_size = Compression::compress(buffer.ptrw() + HEADER_SIZE, body.ptr(), body.size(), Compression::MODE_ZSTD);
+		ERR_FAIL_COND_V_MSG(compressed_size < 0, Vector<uint8_t>(), "Error when trying to compress a GDScript token buffer.");
+		buffer.resize(HEADER_SIZE + compressed_size);
+	} else {
+		encode_uint32(0, &header[8]); // Stored without compression.
+		buffer.append_array(body);
+	}
+
+	return buffer;
+}
+
+Error GDScriptTokenizerBuffer::set_code_buffer(const Vector<uint8_t> &p_buffer) {
+	ERR_FAIL_COND_V_MSG(!is_token_buffer(p_buffer), ERR_INVALID_DATA, "Invalid GDScript token buffer.");
+
+	const uint8_t *buf = p_buffer.ptr();
+	uint32_t version = decode_uint32(&buf[4]);
+	ERR_FAIL_COND_V_MSG(version != TOKENIZER_VERSION, ERR_INVALID_DATA, vformat("GDScript token buffer version %d is not supported (expected %d). Export the project again with this engine version.", version, TOKENIZER_VERSION));
+
+	int decompressed_size = decode_uint32(&buf[8]);
+	if (decompressed_size == 0) {
+		return _decode_body(buf + HEADER_SIZE, p_buffer.size() - HEADER_SIZE);
+	}
+
+	Vector<uint8_t> contents;
+	contents.resize(decompressed_size);
+	int result = Compression::decompress(contents.ptrw(), decompressed_size, buf + HEADER_SIZE, p_buffer.size() - HEADER_SIZE, Compression::MODE_ZSTD);
+	ERR_FAIL_COND_V_MSG(result != decompressed_size, ERR_INVALID_DATA, "Error when trying to decompress a GDScript token buffer.");
+
+	return _decode_body(contents.ptr(), contents.size());
+}
+
+Error GDScriptTokenizerBuffer::_decode_body(const uint8_t *p_body, int p_size) {
+	int pos = 0;
+
+	ERR_FAIL_COND_V(p_size < 20, ERR_INVALID_DATA);
+	uint32_t identifier_count = decode_uint32(&p_body[0]);
+	uint32_t constant_count = decode_uint32(&p_body[4]);
+	uint32_t line_count = decode_uint32(&p_body[8]);
+	uint32_t end_line_count = decode_uint32(&p_body[12]);
+	uint32_t token_count = decode_uint32(&p_body[16]);
+	pos += 20;
+
+	identifiers.resize(identifier_count);
+	for (uint32_t i = 0; i < identifier_count; i++) {
+		ERR_FAIL_COND_V(pos + 4 > p_size, ERR_INVALID_DATA);
+		int len = decode_uint32(&p_body[pos]);
+		pos += 4;
+		ERR_FAIL_COND_V(len < 0 || pos + len > p_size, ERR_INVALID_DATA);
+		String identifier;
+		identifier.parse_utf8((const char *)&p_body[pos], len);
+		identifiers.write[i] = identifier;
+		pos += len;
+	}
+
+	constants.resize(constant_count);
+	for (uint32_t i = 0; i < constant_count; i++) {
+		ERR_FAIL_COND_V(pos + 4 > p_size, ERR_INVALID_DATA);
+		int len = decode_uint32(&p_body[pos]);
+		pos += 4;
+		ERR_FAIL_COND_V(len < 0 || pos + len > p_size, ERR_INVALID_DATA);
+		Error err = decode_variant(constants.write[i], &p_body[pos], len);
+		ERR_FAIL_COND_V(err != OK, err);
+		pos += len;
+	}
+
+	ERR_FAIL_COND_V(pos + int64_t(line_count) * 16 + int64_t(end_line_count) * 8 + int64_t(token_count) * 4 > p_size, ERR_INVALID_DATA);
+
+	for (uint32_t i = 0; i < line_count; i++) {
+		int token_index = decode_uint32(&p_body[pos]);
+		token_lines[token_index] = decode_uint32(&p_body[pos + 4]);
+		token_columns[token_index] = decode_uint32(&p_body[pos + 8]);
+		token_indent_flags[token_index] = decode_uint32(&p_body[pos + 12]);
+		pos += 16;
+	}
+
+	HashMap<int, int> token_end_lines;
+	for (uint32_t i = 0; i < end_line_count; i++) {
+		token_end_lines[decode_uint32(&p_body[pos])] = decode_uint32(&p_body[pos + 4]);
+		pos += 8;
+	}
+
+	tokens.resize(token_count);
+	int line = 1;
+	for (uint32_t i = 0; i < token_count; i++) {
+		uint32_t value = decode_uint32(&p_body[pos]);
+		pos += 4;
+
+		Token::Type type = Token::Type(value & TOKEN_MASK);
+		uint32_t payload = value >> TOKEN_BITS;
+		ERR_FAIL_COND_V(type >= Token::TK_MAX, ERR_INVALID_DATA);
+
+		Token token(type);
+		if (type == Token::LITERAL) {
+			ERR_FAIL_COND_V(payload >= constant_count, ERR_INVALID_DATA);
+			token.literal = constants[payload];
+		} else if (type == Token::ANNOTATION || token.is_node_name()) {
+			ERR_FAIL_COND_V(payload >= identifier_count, ERR_INVALID_DATA);
+			token.source = identifiers[payload];
+			if (type == Token::IDENTIFIER || type == Token::ANNOTATION) {
+				token.literal = identifiers[payload];
+			}
+		}
+
+		if (token_lines.has(i)) {
+			line = token_lines[i];
+			token.start_column = token_columns[i];
+			token.leftmost_column = token.start_column;
+		}
+		token.start_line = line;
+		token.end_line = line;
+		if (token_end_lines.has(i)) {
+			// Following tokens start on the last line of this one.
+			token.end_line = token_end_lines[i];
+			line = token.end_line;
+		}
+		tokens.write[i] = token;
+	}
+
+	return OK;
+}
+
+GDScriptTokenizer::Token GDScriptTokenizerBuffer::_make_whitespace_token(Token::Type p_type) const {
+	Token token(p_type);
+	token.start_line = current_line;
+	token.end_line = current_line;
+	return token;
+}
+
+void GDScriptTokenizerBuffer::_push_indent_error(const String &p_message, int p_column) {
+	Token error(Token::ERROR);
+	error.literal = p_message;
+	error.start_line = current_line;
+	error.end_line = current_line;
+	error.start_column = 1;
+	error.leftmost_column = 1;
+	error.end_column = p_column;
+	error.rightmost_column = p_column;
+	error_stack.push_back(error);
+}
+
+// Same checks as GDScriptTokenizerText::check_indent(), using the whitespace recorded for the line.
+void GDScriptTokenizerBuffer::_check_indent(int p_indent_count, int p_flags) {
+	if (p_flags == 0) {
+		// First character of the line is not whitespace, so we clear all indentation levels.
+		pending_indents -= indent_stack.size();
+		indent_stack.clear();
+		return;
+	}
+
+	if (p_flags & INDENT_MIXED) {
+		_push_indent_error("Mixed use of tabs and spaces for indentation.", p_indent_count + 1);
+	}
+
+	// Check if indentation character is consistent.
+	const int indent_char = p_flags & (INDENT_TABS | INDENT_SPACES);
+	if (indent_flags_used == 0) {
+		indent_flags_used = indent_char;
+	} else if (indent_char != indent_flags_used) {
+		_push_indent_error(vformat("Used %s character for indentation instead of %s as used before in the file.", _get_indent_char_name(indent_char), _get_indent_char_name(indent_flags_used)), p_indent_count + 1);
+	}
+
+	int previous_indent = indent_stack.is_empty() ? 0 : indent_stack.back()->get();
+	if (p_indent_count > previous_indent) {
+		indent_stack.push_back(p_indent_count);
+		pending_indents++;
+	} else if (p_indent_count < previous_indent) {
+		while (!indent_stack.is_empty() && indent_stack.back()->get() > p_indent_count) {
+			indent_stack.pop_back();
+			pending_indents--;
+		}
+		if ((!indent_stack.is_empty() && indent_stack.back()->get() != p_indent_count) || (indent_stack.is_empty() && p_indent_count != 0)) {
+			_push_indent_error("Unindent doesn't match the previous indentation level.", p_indent_count + 2);
+			// Still, we'll be lenient and keep going, so keep this level in the stack.
+			indent_stack.push_back(p_indent_count);
+		}
+	}
+}
+
+int GDScriptTokenizerBuffer::get_cursor_line() const {
+	return 0;
+}
+
+int GDScriptTokenizerBuffer::get_cursor_column() const {
+	return 0;
+}
+
+void GDScriptTokenizerBuffer::set_cursor_position(int p_line, int p_column) {
+}
+
+void GDScriptTokenizerBuffer::set_multiline_mode(bool p_state) {
+	multiline_mode = p_state;
+}
+
+bool GDScriptTokenizerBuffer::is_past_cursor() const {
+	return false;
+}
+
+void GDScriptTokenizerBuffer::push_expression_indented_block() {
+	indent_stack_stack.push_back(indent_stack);
+}
+
+void GDScriptTokenizerBuffer::pop_expression_indented_block() {
+	ERR_FAIL_COND(indent_stack_stack.size() == 0);
+	indent_stack = indent_stack_stack.back()->get();
+	indent_stack_stack.pop_back();
+}
+
+GDScriptTokenizer::Token GDScriptTokenizerBuffer::scan() {
+	// Add final newline.
+	if (current >= tokens.size() && !last_token_was_newline) {
+		last_token_was_newline = true;
+		return _make_whitespace_token(Token::NEWLINE);
+	}
+
+	if (!error_stack.is_empty()) {
+		Token error = error_stack.front()->get();
+		error_stack.pop_front();
+		return error;
+	}
+
+	// Resolve pending indentation change.
+	if (pending_indents > 0) {
+		pending_indents--;
+		return _make_whitespace_token(Token::INDENT);
+	} else if (pending_indents < 0) {
+		pending_indents++;
+		return _make_whitespace_token(Token::DEDENT);
+	}
+
+	if (current >= tokens.size()) {
+		if (!indent_stack.is_empty()) {
+			// Send dedents for every indent level.
+			pending_indents -= indent_stack.size();
+			indent_stack.clear();
+			return scan();
+		}
+		return _make_whitespace_token(Token::TK_EOF);
+	}
+
+	if (current > 0 && !last_token_was_newline && token_lines.has(current)) {
+		current_line = token_lines[current];
+		// Don't return newline tokens or change indentation on multiline mode.
+		if (!multiline_mode) {
+			_check_indent(token_columns[current] - 1, token_indent_flags[current]);
+
+			last_token_was_newline = true;
+			return _make_whitespace_token(Token::NEWLINE);
+		}
+	}
+
+	last_token_was_newline = false;
+	return tokens[current++];
+}
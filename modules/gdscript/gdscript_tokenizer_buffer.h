@@ -0,0 +1,114 @@
+/**************************************************************************/
+/*  gdscript_tokenizer_buffer.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_TOKENIZER_BUFFER_H
+#define GDSCRIPT_TOKENIZER_BUFFER_H
+
+#include "gdscript_tokenizer.h"
+
+// Replays a token stream that was produced ahead of time from a script's
+// source code (see `parse_code_string()`), so exported projects don't need to
+// run the text tokenizer on load. Whitespace tokens are not stored: newlines
+// and indentation changes are rebuilt from the line starts, which keeps them
+// in sync with the multiline mode requested by the parser.
+class GDScriptTokenizerBuffer : public GDScriptTokenizer {
+public:
+	enum CompressMode {
+		COMPRESS_NONE,
+		COMPRESS_ZSTD,
+	};
+
+	enum {
+		TOKEN_BITS = 8,
+		TOKEN_MASK = (1 << TOKEN_BITS) - 1,
+	};
+
+	// Whitespace at the start of a line, so indentation errors can be reported as the text tokenizer does.
+	enum IndentFlags {
+		INDENT_TABS = 1 << 0, // First indentation character is a tab.
+		INDENT_SPACES = 1 << 1, // First indentation character is a space.
+		INDENT_MIXED = 1 << 2,
+	};
+
+	static constexpr uint32_t TOKENIZER_VERSION = 2;
+	static constexpr int HEADER_SIZE = 12;
+
+private:
+	Vector<StringName> identifiers;
+	Vector<Variant> constants;
+	HashMap<int, int> token_lines;
+	HashMap<int, int> token_columns;
+	HashMap<int, int> token_indent_flags;
+	Vector<Token> tokens;
+	int current = 0;
+	int current_line = 1;
+
+	bool multiline_mode = false;
+	List<int> indent_stack;
+	List<List<int>> indent_stack_stack; // For lambdas, which require manipulating the indentation point.
+	int pending_indents = 0;
+	bool last_token_was_newline = false;
+	int indent_flags_used = 0; // Indentation character of the first indented line.
+	List<Token> error_stack;
+
+#ifdef TOOLS_ENABLED
+	HashMap<int, CommentData> dummy;
+#endif // TOOLS_ENABLED
+
+	Token _make_whitespace_token(Token::Type p_type) const;
+	void _push_indent_error(const String &p_message, int p_column);
+	void _check_indent(int p_indent_count, int p_flags);
+	Error _decode_body(const uint8_t *p_body, int p_size);
+
+public:
+	static bool is_token_buffer(const Vector<uint8_t> &p_buffer);
+	static Vector<uint8_t> parse_code_string(const String &p_code, CompressMode p_compress_mode);
+
+	Error set_code_buffer(const Vector<uint8_t> &p_buffer);
+
+	virtual int get_cursor_line() const override;
+	virtual int get_cursor_column() const override;
+	virtual void set_cursor_position(int p_line, int p_column) override;
+	virtual void set_multiline_mode(bool p_state) override;
+	virtual bool is_past_cursor() const override;
+	virtual void push_expression_indented_block() override; // For lambdas, or blocks inside expressions.
+	virtual void pop_expression_indented_block() override; // For lambdas, or blocks inside expressions.
+	virtual bool is_text() override { return false; }
+
+#ifdef TOOLS_ENABLED
+	virtual const HashMap<int, CommentData> &get_comments() const override {
+		return dummy;
+	}
+#endif // TOOLS_ENABLED
+
+	virtual Token scan() override;
+};
+
+#endif // GDSCRIPT_TOKENIZER_BUFFER_H
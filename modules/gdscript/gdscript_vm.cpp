@@ -31,8 +31,10 @@
 #include "gdscript.h"
 #include "gdscript_function.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_vm_profiler.h"
 
 #include "core/core_string_names.h"
+#include "core/debugger/trace_profiler.h"
 #include "core/os/os.h"
 
 #ifdef DEBUG_ENABLED
@@ -86,6 +88,22 @@ static String _get_var_type(const Variant *p_var) {
 }
 #endif // DEBUG_ENABLED
 
+// Returns the GDScript instance of the object in `p_value`, if any, for the member access caches.
+static _FORCE_INLINE_ GDScriptInstance *_get_gdscript_instance(const Variant *p_value) {
+	if (p_value->get_type() != Variant::OBJECT) {
+		return nullptr;
+	}
+	Object *obj = p_value->get_validated_object();
+	if (!obj) {
+		return nullptr;
+	}
+	ScriptInstance *script_instance = obj->get_script_instance();
+	if (!script_instance || script_instance->get_language() != GDScriptLanguage::get_singleton() || script_instance->is_placeholder()) {
+		return nullptr;
+	}
+	return static_cast<GDScriptInstance *>(script_instance);
+}
+
 Variant GDScriptFunction::_get_default_variant_for_data_type(const GDScriptDataType &p_data_type) {
 	if (p_data_type.kind == GDScriptDataType::BUILTIN) {
 		if (p_data_type.builtin_type == Variant::ARRAY) {
@@ -191,6 +209,35 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {        \
 		&&OPCODE_OPERATOR,                           \
 		&&OPCODE_OPERATOR_VALIDATED,                 \
+		&&OPCODE_OPERATOR_ADD_INT,                   \
+		&&OPCODE_OPERATOR_SUBTRACT_INT,              \
+		&&OPCODE_OPERATOR_MULTIPLY_INT,              \
+		&&OPCODE_OPERATOR_EQUAL_INT,                 \
+		&&OPCODE_OPERATOR_NOT_EQUAL_INT,             \
+		&&OPCODE_OPERATOR_LESS_INT,                  \
+		&&OPCODE_OPERATOR_LESS_EQUAL_INT,            \
+		&&OPCODE_OPERATOR_GREATER_INT,               \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_INT,         \
+		&&OPCODE_OPERATOR_ADD_FLOAT,                 \
+		&&OPCODE_OPERATOR_SUBTRACT_FLOAT,            \
+		&&OPCODE_OPERATOR_MULTIPLY_FLOAT,            \
+		&&OPCODE_OPERATOR_DIVIDE_FLOAT,              \
+		&&OPCODE_OPERATOR_EQUAL_FLOAT,               \
+		&&OPCODE_OPERATOR_NOT_EQUAL_FLOAT,           \
+		&&OPCODE_OPERATOR_LESS_FLOAT,                \
+		&&OPCODE_OPERATOR_LESS_EQUAL_FLOAT,          \
+		&&OPCODE_OPERATOR_GREATER_FLOAT,             \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,       \
+		&&OPCODE_OPERATOR_ADD_VECTOR2,               \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR2,          \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR2,          \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT,    \
+		&&OPCODE_OPERATOR_DIVIDE_VECTOR2_FLOAT,      \
+		&&OPCODE_OPERATOR_ADD_VECTOR3,               \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR3,          \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3,          \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT,    \
+		&&OPCODE_OPERATOR_DIVIDE_VECTOR3_FLOAT,      \
 		&&OPCODE_TYPE_TEST_BUILTIN,                  \
 		&&OPCODE_TYPE_TEST_ARRAY,                    \
 		&&OPCODE_TYPE_TEST_NATIVE,                   \
@@ -203,8 +250,10 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_GET_INDEXED_VALIDATED,              \
 		&&OPCODE_SET_NAMED,                          \
 		&&OPCODE_SET_NAMED_VALIDATED,                \
+		&&OPCODE_SET_NAMED_CACHED,                   \
 		&&OPCODE_GET_NAMED,                          \
 		&&OPCODE_GET_NAMED_VALIDATED,                \
+		&&OPCODE_GET_NAMED_CACHED,                   \
 		&&OPCODE_SET_MEMBER,                         \
 		&&OPCODE_GET_MEMBER,                         \
 		&&OPCODE_SET_STATIC_VARIABLE,                \
@@ -212,6 +261,11 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_ASSIGN,                             \
 		&&OPCODE_ASSIGN_TRUE,                        \
 		&&OPCODE_ASSIGN_FALSE,                       \
+		&&OPCODE_ASSIGN_BOOL,                        \
+		&&OPCODE_ASSIGN_INT,                         \
+		&&OPCODE_ASSIGN_FLOAT,                       \
+		&&OPCODE_ASSIGN_VECTOR2,                     \
+		&&OPCODE_ASSIGN_VECTOR3,                     \
 		&&OPCODE_ASSIGN_TYPED_BUILTIN,               \
 		&&OPCODE_ASSIGN_TYPED_ARRAY,                 \
 		&&OPCODE_ASSIGN_TYPED_NATIVE,                \
@@ -383,8 +437,11 @@ void (*type_init_function_table[])(Variant *) = {
 	OPSOUT:
 #define OPCODE_SWITCH(m_test) goto *switch_table_ops[m_test];
 #ifdef DEBUG_ENABLED
-#define DISPATCH_OPCODE          \
-	last_opcode = _code_ptr[ip]; \
+#define DISPATCH_OPCODE                 \
+	last_opcode = _code_ptr[ip];        \
+	if (unlikely(opcode_counts)) {      \
+		opcode_counts[last_opcode]++;   \
+	}                                   \
 	goto *switch_table_ops[last_opcode]
 #else
 #define DISPATCH_OPCODE goto *switch_table_ops[_code_ptr[ip]]
@@ -451,6 +508,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		return _get_default_variant_for_data_type(return_type);
 	}
 
+	TRACE_SCOPE(name);
+
 	r_err.error = Callable::CallError::CALL_OK;
 
 	static thread_local int call_depth = 0;
@@ -499,11 +558,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	if (p_state) {
 		//use existing (supplied) state (awaited)
-		stack = (Variant *)p_state->stack.ptr();
-		instruction_args = (Variant **)&p_state->stack.ptr()[sizeof(Variant) * p_state->stack_size]; //ptr() to avoid bounds check
+		stack = (Variant *)p_state->stack;
+		instruction_args = (Variant **)&p_state->stack[sizeof(Variant) * p_state->stack_size];
 		line = p_state->line;
 		ip = p_state->ip;
-		alloca_size = p_state->stack.size();
+		alloca_size = p_state->alloca_size;
 		script = p_state->script;
 		p_instance = p_state->instance;
 		defarg = p_state->defarg;
@@ -595,6 +654,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	if (EngineDebugger::is_active()) {
 		GDScriptLanguage::get_singleton()->enter_function(p_instance, this, stack, &ip, &line);
+		if (unlikely(GDScriptVMProfiler::is_sample_requested())) {
+			// Requested before this function was entered or resumed, so it belongs to the caller.
+			GDScriptVMProfiler::get_singleton()->record_sample(StringName(), 0);
+		}
 	}
 
 #define GD_ERR_BREAK(m_cond)                                                                                           \
@@ -670,6 +733,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	bool exit_ok = false;
 	bool awaited = false;
 #endif
+	// Set when the stack was handed over to a new function state by an `await` after resuming.
+	bool stack_moved = false;
 
 #ifdef DEBUG_ENABLED
 	int variant_address_limits[ADDR_TYPE_MAX] = { _stack_size, _constant_count, p_instance ? p_instance->members.size() : 0 };
@@ -678,8 +743,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	Variant *variant_addresses[ADDR_TYPE_MAX] = { stack, _constants_ptr, p_instance ? p_instance->members.ptrw() : nullptr };
 
 #ifdef DEBUG_ENABLED
+	uint64_t *opcode_counts = GDScriptLanguage::get_opcode_counts();
+
 	OPCODE_WHILE(ip < _code_size) {
 		int last_opcode = _code_ptr[ip];
+		if (unlikely(opcode_counts)) {
+			opcode_counts[last_opcode]++;
+		}
 #else
 	OPCODE_WHILE(true) {
 #endif
@@ -781,6 +851,64 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_OPERATOR_TYPED(m_op, m_v_type, m_c_type, m_operator, m_ret_type)   \
+	OPCODE(OPCODE_OPERATOR_##m_op##_##m_v_type) {                                 \
+		CHECK_SPACE(4);                                                           \
+		GET_VARIANT_PTR(a, 0);                                                    \
+		GET_VARIANT_PTR(b, 1);                                                    \
+		GET_VARIANT_PTR(dst, 2);                                                  \
+		const m_c_type left = *VariantInternal::OP_GET_##m_v_type(a);             \
+		const m_c_type right = *VariantInternal::OP_GET_##m_v_type(b);            \
+		VariantTypeChanger<m_ret_type>::change(dst);                              \
+		*VariantGetInternalPtr<m_ret_type>::get_ptr(dst) = left m_operator right; \
+		ip += 4;                                                                  \
+	}                                                                             \
+	DISPATCH_OPCODE
+
+#define OPCODE_OPERATOR_VECTOR_FLOAT(m_op, m_v_type, m_c_type, m_operator) \
+	OPCODE(OPCODE_OPERATOR_##m_op##_##m_v_type##_FLOAT) {                  \
+		CHECK_SPACE(4);                                                    \
+		GET_VARIANT_PTR(a, 0);                                             \
+		GET_VARIANT_PTR(b, 1);                                             \
+		GET_VARIANT_PTR(dst, 2);                                           \
+		const m_c_type left = *VariantInternal::OP_GET_##m_v_type(a);      \
+		const double right = *VariantInternal::get_float(b);               \
+		VariantTypeChanger<m_c_type>::change(dst);                         \
+		*VariantInternal::OP_GET_##m_v_type(dst) = left m_operator right;  \
+		ip += 4;                                                           \
+	}                                                                      \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_TYPED(ADD, INT, int64_t, +, int64_t);
+			OPCODE_OPERATOR_TYPED(SUBTRACT, INT, int64_t, -, int64_t);
+			OPCODE_OPERATOR_TYPED(MULTIPLY, INT, int64_t, *, int64_t);
+			OPCODE_OPERATOR_TYPED(EQUAL, INT, int64_t, ==, bool);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL, INT, int64_t, !=, bool);
+			OPCODE_OPERATOR_TYPED(LESS, INT, int64_t, <, bool);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL, INT, int64_t, <=, bool);
+			OPCODE_OPERATOR_TYPED(GREATER, INT, int64_t, >, bool);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL, INT, int64_t, >=, bool);
+			OPCODE_OPERATOR_TYPED(ADD, FLOAT, double, +, double);
+			OPCODE_OPERATOR_TYPED(SUBTRACT, FLOAT, double, -, double);
+			OPCODE_OPERATOR_TYPED(MULTIPLY, FLOAT, double, *, double);
+			OPCODE_OPERATOR_TYPED(DIVIDE, FLOAT, double, /, double);
+			OPCODE_OPERATOR_TYPED(EQUAL, FLOAT, double, ==, bool);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL, FLOAT, double, !=, bool);
+			OPCODE_OPERATOR_TYPED(LESS, FLOAT, double, <, bool);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL, FLOAT, double, <=, bool);
+			OPCODE_OPERATOR_TYPED(GREATER, FLOAT, double, >, bool);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL, FLOAT, double, >=, bool);
+			OPCODE_OPERATOR_TYPED(ADD, VECTOR2, Vector2, +, Vector2);
+			OPCODE_OPERATOR_TYPED(SUBTRACT, VECTOR2, Vector2, -, Vector2);
+			OPCODE_OPERATOR_TYPED(MULTIPLY, VECTOR2, Vector2, *, Vector2);
+			OPCODE_OPERATOR_VECTOR_FLOAT(MULTIPLY, VECTOR2, Vector2, *);
+			OPCODE_OPERATOR_VECTOR_FLOAT(DIVIDE, VECTOR2, Vector2, /);
+			OPCODE_OPERATOR_TYPED(ADD, VECTOR3, Vector3, +, Vector3);
+			OPCODE_OPERATOR_TYPED(SUBTRACT, VECTOR3, Vector3, -, Vector3);
+			OPCODE_OPERATOR_TYPED(MULTIPLY, VECTOR3, Vector3, *, Vector3);
+			OPCODE_OPERATOR_VECTOR_FLOAT(MULTIPLY, VECTOR3, Vector3, *);
+			OPCODE_OPERATOR_VECTOR_FLOAT(DIVIDE, VECTOR3, Vector3, /);
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1119,6 +1247,57 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_SET_NAMED_CACHED) {
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(dst, 0);
+				GET_VARIANT_PTR(value, 1);
+
+				int indexname = _code_ptr[ip + 3];
+				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+				const StringName *index = &_global_names_ptr[indexname];
+
+				int cache_index = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _member_caches_count);
+				SafeNumeric<uint64_t> &cache = member_caches[cache_index];
+
+				GDScriptInstance *dst_instance = _get_gdscript_instance(dst);
+				const uint64_t entry = cache.get();
+				const uint32_t member_index = entry & GDScript::MEMBER_CACHE_INDEX_MASK;
+				const uint32_t member_type = (entry >> GDScript::MEMBER_CACHE_TYPE_SHIFT) & 0xFF;
+				if (dst_instance && entry && uint32_t(entry >> 32) == dst_instance->script->member_layout_id && member_index < (uint32_t)dst_instance->members.size() &&
+						(member_type == GDScript::MEMBER_CACHE_TYPE_ANY || member_type == uint32_t(value->get_type()) + 1)) {
+					dst_instance->members.write[member_index] = *value;
+#ifdef TOOLS_ENABLED
+					dst_instance->owner->set_edited(true);
+#endif
+				} else {
+					bool valid;
+					dst->set_named(*index, *value, valid);
+
+#ifdef DEBUG_ENABLED
+					if (!valid) {
+						Object *obj = dst->get_validated_object();
+						bool read_only_property = false;
+						if (obj) {
+							read_only_property = ClassDB::has_property(obj->get_class_name(), *index) && (ClassDB::get_property_setter(obj->get_class_name(), *index) == StringName());
+						}
+						if (read_only_property) {
+							err_text = vformat(R"(Cannot set value into property "%s" (on base "%s") because it is read-only.)", String(*index), _get_var_type(dst));
+						} else {
+							err_text = "Invalid set index '" + String(*index) + "' (on base: '" + _get_var_type(dst) + "') with value of type '" + _get_var_type(value) + "'.";
+						}
+						OPCODE_BREAK;
+					}
+#endif
+					if (dst_instance) {
+						cache.set(dst_instance->script->get_member_cache_entry(*index));
+					}
+				}
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_GET_NAMED) {
 				CHECK_SPACE(4);
 
@@ -1164,6 +1343,49 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_GET_NAMED_CACHED) {
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(src, 0);
+				GET_VARIANT_PTR(dst, 1);
+
+				int indexname = _code_ptr[ip + 3];
+				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+				const StringName *index = &_global_names_ptr[indexname];
+
+				int cache_index = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_index < 0 || cache_index >= _member_caches_count);
+				SafeNumeric<uint64_t> &cache = member_caches[cache_index];
+
+				GDScriptInstance *src_instance = _get_gdscript_instance(src);
+				const uint64_t entry = cache.get();
+				const uint32_t member_index = entry & GDScript::MEMBER_CACHE_INDEX_MASK;
+				if (src_instance && entry && uint32_t(entry >> 32) == src_instance->script->member_layout_id && member_index < (uint32_t)src_instance->members.size()) {
+					if (unlikely(dst == src)) {
+						// Overwriting `src` may free the instance holding the value.
+						Variant ret = src_instance->members[member_index];
+						*dst = ret;
+					} else {
+						*dst = src_instance->members[member_index];
+					}
+				} else {
+					bool valid;
+					Variant ret = src->get_named(*index, valid);
+#ifdef DEBUG_ENABLED
+					if (!valid) {
+						err_text = "Invalid get index '" + index->operator String() + "' (on base: '" + _get_var_type(src) + "').";
+						OPCODE_BREAK;
+					}
+#endif
+					if (src_instance) {
+						cache.set(src_instance->script->get_member_cache_entry(*index));
+					}
+					*dst = ret;
+				}
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_SET_MEMBER) {
 				CHECK_SPACE(3);
 				GET_VARIANT_PTR(src, 0);
@@ -1274,6 +1496,23 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_ASSIGN_INLINE(m_v_type, m_c_type)                                             \
+	OPCODE(OPCODE_ASSIGN_##m_v_type) {                                                       \
+		CHECK_SPACE(3);                                                                      \
+		GET_VARIANT_PTR(dst, 0);                                                             \
+		GET_VARIANT_PTR(src, 1);                                                             \
+		VariantTypeChanger<m_c_type>::change(dst);                                           \
+		*VariantInternal::OP_GET_##m_v_type(dst) = *VariantInternal::OP_GET_##m_v_type(src); \
+		ip += 3;                                                                             \
+	}                                                                                        \
+	DISPATCH_OPCODE
+
+			OPCODE_ASSIGN_INLINE(BOOL, bool);
+			OPCODE_ASSIGN_INLINE(INT, int64_t);
+			OPCODE_ASSIGN_INLINE(FLOAT, double);
+			OPCODE_ASSIGN_INLINE(VECTOR2, Vector2);
+			OPCODE_ASSIGN_INLINE(VECTOR3, Vector3);
+
 			OPCODE(OPCODE_ASSIGN_TYPED_BUILTIN) {
 				CHECK_SPACE(4);
 				GET_VARIANT_PTR(dst, 0);
@@ -2402,11 +2641,19 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
 					gdfs->function = this;
 
-					gdfs->state.stack.resize(alloca_size);
+					if (p_state) {
+						// Already running on a saved stack, so the new state can take it over without copying.
+						gdfs->state.stack = p_state->stack;
+						p_state->stack = nullptr;
+						p_state->stack_size = 0;
+						stack_moved = true;
+					} else {
+						gdfs->state.stack = GDScriptFunctionState::_alloc_stack(alloca_size);
 
-					// First 3 stack addresses are special, so we just skip them here.
-					for (int i = 3; i < _stack_size; i++) {
-						memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
+						// First 3 stack addresses are special, so we just skip them here.
+						for (int i = 3; i < _stack_size; i++) {
+							memnew_placement(&gdfs->state.stack[sizeof(Variant) * i], Variant(stack[i]));
+						}
 					}
 					gdfs->state.stack_size = _stack_size;
 					gdfs->state.alloca_size = alloca_size;
@@ -2432,10 +2679,23 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 					retvalue = gdfs;
 
-					Error err = sig.connect(Callable(gdfs.ptr(), "_signal_callback").bind(retvalue), Object::CONNECT_ONE_SHOT);
-					if (err != OK) {
-						err_text = "Error connecting to signal: " + sig.get_name() + " during await.";
-						OPCODE_BREAK;
+					if (!GDScriptLanguage::get_singleton()->await_next_frame(sig, gdfs)) {
+						Error err = sig.connect(Callable(gdfs.ptr(), "_signal_callback").bind(retvalue), Object::CONNECT_ONE_SHOT);
+						if (err != OK) {
+							// Nothing will resume the new state, so its stack must not outlive this call.
+							if (stack_moved) {
+								// Give the stack back, it's then cleaned up as if it never moved.
+								p_state->stack = gdfs->state.stack;
+								p_state->stack_size = _stack_size;
+								gdfs->state.stack = nullptr;
+								gdfs->state.stack_size = 0;
+								stack_moved = false;
+							} else {
+								gdfs->_clear_stack();
+							}
+							err_text = "Error connecting to signal: " + sig.get_name() + " during await.";
+							OPCODE_BREAK;
+						}
 					}
 
 #ifdef DEBUG_ENABLED
@@ -3588,6 +3848,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE(OPCODE_LINE) {
 				CHECK_SPACE(2);
 
+#ifdef DEBUG_ENABLED
+				if (unlikely(GDScriptVMProfiler::is_sample_requested())) {
+					// Attribute the sample to the line that was running when it was requested.
+					GDScriptVMProfiler::get_singleton()->record_sample(source, line);
+				}
+#endif
+
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
@@ -3694,8 +3961,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 
 		// Free stack, except reserved addresses.
-		for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
-			stack[i].~Variant();
+		if (!stack_moved) {
+			for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
+				stack[i].~Variant();
+			}
 		}
 #ifdef DEBUG_ENABLED
 	}
@@ -0,0 +1,179 @@
+/**************************************************************************/
+/*  gdscript_vm_profiler.cpp                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_vm_profiler.h"
+
+#ifdef DEBUG_ENABLED
+
+#include "gdscript.h"
+
+#include "core/debugger/engine_debugger.h"
+#include "core/os/os.h"
+
+GDScriptVMProfiler *GDScriptVMProfiler::singleton = nullptr;
+SafeFlag GDScriptVMProfiler::sample_requested;
+
+void GDScriptVMProfiler::_sampler_thread_func(void *p_userdata) {
+	GDScriptVMProfiler *profiler = static_cast<GDScriptVMProfiler *>(p_userdata);
+	while (!profiler->sampler_exit.is_set()) {
+		OS::get_singleton()->delay_usec(profiler->sample_interval_usec);
+		if (!sample_requested.is_set()) {
+			// Keep the time of a request that wasn't taken yet, it tells how long the line has been running.
+			profiler->sample_requested_usec.set(OS::get_singleton()->get_ticks_usec());
+			sample_requested.set();
+		}
+	}
+}
+
+void GDScriptVMProfiler::record_sample(const StringName &p_source, int p_line) {
+	if (!Thread::is_main_thread()) {
+		return;
+	}
+	const uint64_t requested_usec = sample_requested_usec.get();
+	sample_requested.clear();
+
+	// Every interval elapsed since the request was spent on the same line.
+	const uint64_t elapsed_usec = OS::get_singleton()->get_ticks_usec() - requested_usec;
+	const uint64_t samples = 1 + elapsed_usec / sample_interval_usec;
+	sample_count += samples;
+
+	StringName source = p_source;
+	int line = p_line;
+	if (line == 0) {
+		// The function was just entered, the request was raised in its caller.
+		ScriptLanguage *language = GDScriptLanguage::get_singleton();
+		if (language->debug_get_stack_level_count() < 2) {
+			outside_script_sample_count += samples;
+			return;
+		}
+		source = language->debug_get_stack_level_source(1);
+		line = language->debug_get_stack_level_line(1);
+	}
+
+	HashMap<StringName, HashMap<int, uint64_t>>::Iterator E = line_samples.find(source);
+	if (!E) {
+		E = line_samples.insert(source, HashMap<int, uint64_t>());
+	}
+	HashMap<int, uint64_t>::Iterator L = E->value.find(line);
+	if (L) {
+		L->value += samples;
+	} else {
+		E->value.insert(line, samples);
+	}
+}
+
+void GDScriptVMProfiler::toggle(bool p_enable, const Array &p_opts) {
+	if (p_enable == enabled) {
+		return;
+	}
+	enabled = p_enable;
+
+	if (p_enable) {
+		sample_interval_usec = 1000;
+		if (p_opts.size() > 0 && p_opts[0].get_type() == Variant::INT) {
+			sample_interval_usec = MAX(100, int64_t(p_opts[0]));
+		}
+		line_samples.clear();
+		sample_count = 0;
+		outside_script_sample_count = 0;
+		memset(opcode_counts, 0, sizeof(opcode_counts));
+		GDScriptLanguage::set_opcode_counts(opcode_counts);
+
+		sampler_exit.clear();
+		sampler_thread.start(_sampler_thread_func, this);
+	} else {
+		GDScriptLanguage::set_opcode_counts(nullptr);
+
+		sampler_exit.set();
+		sampler_thread.wait_to_finish();
+		sample_requested.clear();
+		_send_data(); // Send the final numbers.
+	}
+}
+
+void GDScriptVMProfiler::tick(double p_frame_time, double p_process_time, double p_physics_time, double p_physics_frame_time) {
+	if (!enabled) {
+		return;
+	}
+	const uint64_t now = OS::get_singleton()->get_ticks_msec();
+	if (now - last_send_msec > 500) {
+		last_send_msec = now;
+		_send_data();
+	}
+}
+
+void GDScriptVMProfiler::_send_data() {
+	// Totals since the profiler was enabled:
+	// [sample_interval_usec, sample_count, outside_script_sample_count,
+	//  opcode_entry_count, (opcode_name, executed_count) * opcode_entry_count,
+	//  line_entry_count, (source_path, line, sample_count) * line_entry_count]
+	Array data;
+	data.push_back(sample_interval_usec);
+	data.push_back(sample_count);
+	data.push_back(outside_script_sample_count);
+
+	Array opcodes;
+	for (int i = 0; i <= GDScriptFunction::OPCODE_END; i++) {
+		if (opcode_counts[i] > 0) {
+			opcodes.push_back(GDScriptFunction::get_opcode_name(GDScriptFunction::Opcode(i)));
+			opcodes.push_back(opcode_counts[i]);
+		}
+	}
+
+	Array lines;
+	for (const KeyValue<StringName, HashMap<int, uint64_t>> &E : line_samples) {
+		for (const KeyValue<int, uint64_t> &L : E.value) {
+			lines.push_back(String(E.key));
+			lines.push_back(L.key);
+			lines.push_back(L.value);
+		}
+	}
+
+	data.push_back(opcodes.size() / 2);
+	data.append_array(opcodes);
+	data.push_back(lines.size() / 3);
+	data.append_array(lines);
+	EngineDebugger::get_singleton()->send_message("gdscript:vm", data);
+}
+
+GDScriptVMProfiler::GDScriptVMProfiler() {
+	singleton = this;
+}
+
+GDScriptVMProfiler::~GDScriptVMProfiler() {
+	if (enabled) {
+		GDScriptLanguage::set_opcode_counts(nullptr);
+		sampler_exit.set();
+		sampler_thread.wait_to_finish();
+	}
+	singleton = nullptr;
+}
+
+#endif // DEBUG_ENABLED
@@ -0,0 +1,90 @@
+/**************************************************************************/
+/*  gdscript_vm_profiler.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_VM_PROFILER_H
+#define GDSCRIPT_VM_PROFILER_H
+
+#ifdef DEBUG_ENABLED
+
+#include "gdscript_function.h"
+
+#include "core/debugger/engine_profiler.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/safe_refcount.h"
+
+// Debugger profiler ("gdscript:vm") that counts the opcodes executed and samples which
+// script lines are running.
+//
+// A sampler thread raises a flag at a fixed interval. The next OPCODE_LINE or function call
+// records a sample for the line that was running when the flag was raised, weighted by the
+// number of intervals elapsed since, so lines blocked in a long native call are not
+// under-counted. Time spent outside of any script is counted separately. Sampling costs a
+// single flag check per line while it's idle.
+//
+// Only the main thread is profiled, scripts running on other threads are neither counted nor
+// sampled. The editor has no view for this data yet: it's sent to the debugger as
+// "gdscript:vm" messages, for an EditorDebuggerPlugin or an external tool to display.
+class GDScriptVMProfiler : public EngineProfiler {
+	GDCLASS(GDScriptVMProfiler, EngineProfiler);
+
+	static GDScriptVMProfiler *singleton;
+	static SafeFlag sample_requested;
+
+	Thread sampler_thread;
+	SafeFlag sampler_exit;
+	SafeNumeric<uint64_t> sample_requested_usec;
+	uint64_t sample_interval_usec = 1000;
+	uint64_t last_send_msec = 0;
+	bool enabled = false;
+
+	uint64_t opcode_counts[GDScriptFunction::OPCODE_END + 1] = {};
+	HashMap<StringName, HashMap<int, uint64_t>> line_samples;
+	uint64_t sample_count = 0;
+	uint64_t outside_script_sample_count = 0; // Time between script calls.
+
+	static void _sampler_thread_func(void *p_userdata);
+	void _send_data();
+
+public:
+	_FORCE_INLINE_ static GDScriptVMProfiler *get_singleton() { return singleton; }
+	_FORCE_INLINE_ static bool is_sample_requested() { return sample_requested.is_set(); }
+	void record_sample(const StringName &p_source, int p_line); // Main thread only. Line 0 means the caller's current line.
+
+	virtual void toggle(bool p_enable, const Array &p_opts) override;
+	virtual void tick(double p_frame_time, double p_process_time, double p_physics_time, double p_physics_frame_time) override;
+
+	GDScriptVMProfiler();
+	~GDScriptVMProfiler();
+};
+
+#endif // DEBUG_ENABLED
+
+#endif // GDSCRIPT_VM_PROFILER_H
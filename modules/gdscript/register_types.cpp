@@ -34,7 +34,9 @@
 #include "gdscript_analyzer.h"
 #include "gdscript_cache.h"
 #include "gdscript_tokenizer.h"
+#include "gdscript_tokenizer_buffer.h"
 #include "gdscript_utility_functions.h"
+#include "gdscript_vm_profiler.h"
 
 #ifdef TOOLS_ENABLED
 #include "editor/gdscript_highlighter.h"
@@ -73,6 +75,9 @@ GDScriptLanguage *script_language_gd = nullptr;
 Ref<ResourceFormatLoaderGDScript> resource_loader_gd;
 Ref<ResourceFormatSaverGDScript> resource_saver_gd;
 GDScriptCache *gdscript_cache = nullptr;
+#ifdef DEBUG_ENABLED
+Ref<GDScriptVMProfiler> gdscript_vm_profiler;
+#endif
 
 #ifdef TOOLS_ENABLED
 
@@ -81,7 +86,17 @@ Ref<GDScriptEditorTranslationParserPlugin> gdscript_translation_parser_plugin;
 class EditorExportGDScript : public EditorExportPlugin {
 	GDCLASS(EditorExportGDScript, EditorExportPlugin);
 
+	enum ExportMode {
+		EXPORT_TEXT,
+		EXPORT_BINARY_TOKENS,
+		EXPORT_BINARY_TOKENS_COMPRESSED,
+	};
+
 public:
+	virtual void _get_export_options(const Ref<EditorExportPlatform> &p_export_platform, List<EditorExportPlatform::ExportOption> *r_options) const override {
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::INT, "script/gdscript_export_mode", PROPERTY_HINT_ENUM, "Text,Binary Tokens,Compressed Binary Tokens"), EXPORT_TEXT));
+	}
+
 	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
 		String script_key;
 
@@ -95,7 +110,20 @@ public:
 			return;
 		}
 
-		return;
+		int export_mode = get_option("script/gdscript_export_mode");
+		if (export_mode == EXPORT_TEXT) {
+			return;
+		}
+
+		// Store the token stream so the text tokenizer doesn't run when the exported project loads the script.
+		String source = FileAccess::get_file_as_string(p_path);
+		Vector<uint8_t> file = GDScriptTokenizerBuffer::parse_code_string(source, export_mode == EXPORT_BINARY_TOKENS_COMPRESSED ? GDScriptTokenizerBuffer::COMPRESS_ZSTD : GDScriptTokenizerBuffer::COMPRESS_NONE);
+		if (file.is_empty()) {
+			// The script doesn't tokenize cleanly, keep the text so the error can be reported when loading it.
+			return;
+		}
+
+		add_file(p_path.get_basename() + ".gdc", file, true);
 	}
 
 	virtual String get_name() const override { return "GDScript"; }
@@ -138,6 +166,11 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 		gdscript_cache = memnew(GDScriptCache);
 
 		GDScriptUtilityFunctions::register_functions();
+
+#ifdef DEBUG_ENABLED
+		gdscript_vm_profiler.instantiate();
+		gdscript_vm_profiler->bind("gdscript:vm");
+#endif
 	}
 
 #ifdef TOOLS_ENABLED
@@ -152,6 +185,10 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 
 void uninitialize_gdscript_module(ModuleInitializationLevel p_level) {
 	if (p_level == MODULE_INITIALIZATION_LEVEL_SERVERS) {
+#ifdef DEBUG_ENABLED
+		gdscript_vm_profiler.unref();
+#endif
+
 		ScriptServer::unregister_language(script_language_gd);
 
 		if (gdscript_cache) {
@@ -0,0 +1,12 @@
+# Inserting, reading and erasing keys of an untyped dictionary.
+
+func benchmark():
+	var dict := {}
+	for i in 1000:
+		dict[i] = i * 2
+	var total := 0
+	for i in 1000:
+		total += dict[i]
+	for i in 1000:
+		dict.erase(i)
+	return total
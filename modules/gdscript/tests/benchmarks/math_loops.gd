@@ -0,0 +1,14 @@
+# Typed arithmetic on numbers and vectors in tight loops.
+
+func benchmark():
+	var sum := 0
+	for i in 1000:
+		sum = sum + i * i - (i >> 1)
+	var x := 0.0
+	for i in 1000:
+		x = x * 0.5 + float(i) / 3.0
+	var position := Vector3.ZERO
+	var velocity := Vector3(1.0, 2.0, 3.0)
+	for i in 1000:
+		position = position + velocity * 0.016
+	return sum + int(x) + int(position.length())
@@ -0,0 +1,16 @@
+# Reading and writing script members and native properties.
+
+class Data:
+	var position := Vector2()
+	var speed := 1.5
+	var count := 0
+
+var data := Data.new()
+var object := RefCounted.new()
+
+func benchmark():
+	for i in 1000:
+		data.position += Vector2(data.speed, 0.0)
+		data.count += 1
+		object.set_meta(&"count", data.count)
+	return data.count
@@ -0,0 +1,17 @@
+# Emitting a signal connected to several script methods.
+
+signal value_changed(value: int)
+
+var received := 0
+
+func setup():
+	for i in 4:
+		value_changed.connect(_on_value_changed.bind(i))
+
+func _on_value_changed(value: int, _extra := 0):
+	received += value
+
+func benchmark():
+	for i in 200:
+		value_changed.emit(i)
+	return received
@@ -0,0 +1,11 @@
+# Concatenating, formatting and joining strings.
+
+func benchmark():
+	var text := ""
+	for i in 200:
+		text += str(i) + ","
+	var parts := PackedStringArray()
+	for i in 200:
+		parts.push_back("item_%d" % i)
+	var joined := ", ".join(parts)
+	return text.length() + joined.length()
@@ -0,0 +1,15 @@
+# Filling, iterating and sorting typed arrays.
+
+var values: Array[int] = []
+
+func setup():
+	values.resize(1000)
+
+func benchmark():
+	for i in values.size():
+		values[i] = (i * 7919) % 1000
+	var total := 0
+	for value in values:
+		total += value
+	values.sort()
+	return total
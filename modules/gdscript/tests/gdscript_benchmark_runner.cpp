@@ -0,0 +1,282 @@
+/**************************************************************************/
+/*  gdscript_benchmark_runner.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_benchmark_runner.h"
+
+#include "gdscript_test_runner.h"
+
+#include "../gdscript.h"
+#include "../gdscript_cache.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/memory.h"
+#include "core/os/os.h"
+
+namespace GDScriptTests {
+
+StringName GDScriptBenchmarkRunner::benchmark_function_name;
+StringName GDScriptBenchmarkRunner::setup_function_name;
+
+void GDScriptBenchmarkRunner::handle_cmdline(const List<String> &p_args) {
+	String path = "modules/gdscript/tests/benchmarks";
+	int iterations = 1000;
+	String json_path;
+	String baseline_path;
+	double tolerance = 10.0;
+
+	for (const List<String>::Element *E = p_args.front(); E; E = E->next()) {
+		const String &arg = E->get();
+		if (!E->next()) {
+			break;
+		}
+		const String &value = E->next()->get();
+		if (arg == "--gdscript-benchmark" && !value.begins_with("--")) {
+			path = value;
+		} else if (arg == "--gdscript-benchmark-iterations") {
+			iterations = MAX(1, value.to_int());
+		} else if (arg == "--gdscript-benchmark-json") {
+			json_path = value;
+		} else if (arg == "--gdscript-benchmark-baseline") {
+			baseline_path = value;
+		} else if (arg == "--gdscript-benchmark-tolerance") {
+			tolerance = value.to_float();
+		}
+	}
+
+	GDScriptBenchmarkRunner runner(path, iterations, false);
+	Vector<Result> results;
+	if (!runner.run(results)) {
+		exit(-1);
+	}
+	print_results(results);
+
+	if (!json_path.is_empty()) {
+		Ref<FileAccess> f = FileAccess::open(json_path, FileAccess::WRITE);
+		if (f.is_null()) {
+			print_line("Could not write benchmark results to " + json_path);
+			exit(-1);
+		}
+		f->store_string(results_to_json(results));
+		print_line("Saved benchmark results to " + json_path);
+	}
+
+	int regressions = 0;
+	if (!baseline_path.is_empty()) {
+		regressions = compare_to_baseline(results, baseline_path, tolerance);
+	}
+	exit(regressions > 0 ? 1 : 0);
+}
+
+GDScriptBenchmarkRunner::GDScriptBenchmarkRunner(const String &p_source_dir, int p_iterations, bool p_init_language) {
+	benchmark_function_name = StaticCString::create("benchmark");
+	setup_function_name = StaticCString::create("setup");
+	iterations = p_iterations;
+	do_init_languages = p_init_language;
+
+	source_dir = p_source_dir;
+	if (!source_dir.ends_with("/")) {
+		source_dir += "/";
+	}
+
+	if (do_init_languages) {
+		init_language(p_source_dir);
+	}
+}
+
+GDScriptBenchmarkRunner::~GDScriptBenchmarkRunner() {
+	benchmark_function_name = StringName();
+	setup_function_name = StringName();
+	if (do_init_languages) {
+		finish_language();
+	}
+}
+
+bool GDScriptBenchmarkRunner::make_benchmarks_for_dir(const String &p_dir, Vector<String> &r_paths) const {
+	Ref<DirAccess> dir = DirAccess::open(p_dir);
+	ERR_FAIL_COND_V_MSG(dir.is_null(), false, "Could not open benchmark directory: " + p_dir);
+
+	const String current_dir = dir->get_current_dir();
+	dir->list_dir_begin();
+	for (String next = dir->get_next(); !next.is_empty(); next = dir->get_next()) {
+		if (dir->current_is_dir()) {
+			if (next != "." && next != ".." && !make_benchmarks_for_dir(current_dir.path_join(next), r_paths)) {
+				return false;
+			}
+		} else if (next.get_extension().to_lower() == "gd") {
+			r_paths.push_back(current_dir.path_join(next));
+		}
+	}
+	dir->list_dir_end();
+
+	return true;
+}
+
+bool GDScriptBenchmarkRunner::run(Vector<Result> &r_results) {
+	Ref<DirAccess> dir = DirAccess::open(source_dir);
+	ERR_FAIL_COND_V_MSG(dir.is_null(), false, "Could not open specified benchmark directory.");
+	source_dir = dir->get_current_dir() + "/"; // Make it absolute path.
+
+	Vector<String> paths;
+	if (!make_benchmarks_for_dir(dir->get_current_dir(), paths)) {
+		return false;
+	}
+	paths.sort();
+
+	for (const String &path : paths) {
+		Result result;
+		result.name = path.trim_prefix(source_dir).get_basename();
+		if (!run_benchmark(path, result)) {
+			return false;
+		}
+		r_results.push_back(result);
+	}
+	return true;
+}
+
+bool GDScriptBenchmarkRunner::run_benchmark(const String &p_path, Result &r_result) const {
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_path(p_path);
+	Error err = script->load_source_code(p_path);
+	ERR_FAIL_COND_V_MSG(err != OK, false, "Could not load benchmark: " + p_path);
+	err = script->reload();
+	ERR_FAIL_COND_V_MSG(err != OK, false, "Could not compile benchmark: " + p_path);
+	ERR_FAIL_COND_V_MSG(!script->get_member_functions().has(benchmark_function_name), false, "Benchmark has no benchmark() function: " + p_path);
+
+	Object *obj = ClassDB::instantiate(script->get_native()->get_name());
+	Ref<RefCounted> obj_ref;
+	if (obj->is_ref_counted()) {
+		obj_ref = Ref<RefCounted>(Object::cast_to<RefCounted>(obj));
+	}
+	obj->set_script(script);
+	ScriptInstance *instance = obj->get_script_instance();
+
+	Callable::CallError call_err;
+	if (script->get_member_functions().has(setup_function_name)) {
+		instance->callp(setup_function_name, nullptr, 0, call_err);
+	}
+	// The first call also warms up caches and lazily created state.
+	if (call_err.error == Callable::CallError::CALL_OK) {
+		instance->callp(benchmark_function_name, nullptr, 0, call_err);
+	}
+
+	if (call_err.error == Callable::CallError::CALL_OK) {
+		const uint64_t allocs_before = Memory::get_total_allocs();
+		const uint64_t start = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < iterations; i++) {
+			instance->callp(benchmark_function_name, nullptr, 0, call_err);
+		}
+		const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - start;
+		const uint64_t allocs = Memory::get_total_allocs() - allocs_before;
+
+		r_result.iterations = iterations;
+		r_result.ns_per_op = double(elapsed) * 1000.0 / iterations;
+		r_result.allocs_per_op = double(allocs) / iterations;
+
+#ifdef DEBUG_ENABLED
+		// Counting slows the VM down, so it's done in a separate, untimed call.
+		uint64_t opcode_counts[GDScriptFunction::OPCODE_END + 1] = {};
+		GDScriptLanguage::set_opcode_counts(opcode_counts);
+		instance->callp(benchmark_function_name, nullptr, 0, call_err);
+		GDScriptLanguage::set_opcode_counts(nullptr);
+		for (const uint64_t count : opcode_counts) {
+			r_result.opcodes_per_op += count;
+		}
+#endif
+	}
+
+	if (obj_ref.is_null()) {
+		memdelete(obj);
+	}
+	GDScriptCache::remove_script(script->get_path());
+
+	ERR_FAIL_COND_V_MSG(call_err.error != Callable::CallError::CALL_OK, false, "Could not call benchmark function on: " + p_path);
+	return true;
+}
+
+void GDScriptBenchmarkRunner::print_results(const Vector<Result> &p_results) {
+	print_line(vformat("%-32s %14s %12s %12s", "benchmark", "ns/op", "allocs/op", "opcodes/op"));
+	for (const Result &result : p_results) {
+		print_line(vformat("%-32s %14.1f %12.1f %12d", result.name, result.ns_per_op, result.allocs_per_op, (int64_t)result.opcodes_per_op));
+	}
+}
+
+String GDScriptBenchmarkRunner::results_to_json(const Vector<Result> &p_results) {
+	Array benchmarks;
+	for (const Result &result : p_results) {
+		Dictionary entry;
+		entry["name"] = result.name;
+		entry["iterations"] = result.iterations;
+		entry["ns_per_op"] = result.ns_per_op;
+		entry["allocs_per_op"] = result.allocs_per_op;
+		entry["opcodes_per_op"] = result.opcodes_per_op;
+		benchmarks.push_back(entry);
+	}
+
+	Dictionary data;
+	data["benchmarks"] = benchmarks;
+	return JSON::stringify(data, "\t", false);
+}
+
+int GDScriptBenchmarkRunner::compare_to_baseline(const Vector<Result> &p_results, const String &p_baseline_path, double p_tolerance_percent) {
+	Error err = OK;
+	const String text = FileAccess::get_file_as_string(p_baseline_path, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, 0, "Could not read benchmark baseline: " + p_baseline_path);
+	const Dictionary baseline = JSON::parse_string(text);
+	ERR_FAIL_COND_V_MSG(!baseline.has("benchmarks"), 0, "Invalid benchmark baseline: " + p_baseline_path);
+
+	HashMap<String, double> baseline_times;
+	const Array benchmarks = baseline["benchmarks"];
+	for (int i = 0; i < benchmarks.size(); i++) {
+		const Dictionary entry = benchmarks[i];
+		baseline_times[entry.get("name", String())] = entry.get("ns_per_op", 0.0);
+	}
+
+	int regressions = 0;
+	print_line(vformat("\nCompared to %s (tolerance: %.1f%%):", p_baseline_path, p_tolerance_percent));
+	for (const Result &result : p_results) {
+		const HashMap<String, double>::ConstIterator E = baseline_times.find(result.name);
+		if (!E || E->value <= 0.0) {
+			print_line(vformat("%-32s %14s", result.name, "new"));
+			continue;
+		}
+		const double change = (result.ns_per_op - E->value) * 100.0 / E->value;
+		const bool regressed = change > p_tolerance_percent;
+		if (regressed) {
+			regressions++;
+		}
+		print_line(vformat("%-32s %+13.1f%%%s", result.name, change, regressed ? "  REGRESSION" : ""));
+	}
+	return regressions;
+}
+
+} // namespace GDScriptTests
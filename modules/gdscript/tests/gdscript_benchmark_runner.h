@@ -0,0 +1,82 @@
+/**************************************************************************/
+/*  gdscript_benchmark_runner.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BENCHMARK_RUNNER_H
+#define GDSCRIPT_BENCHMARK_RUNNER_H
+
+#include "core/string/string_name.h"
+#include "core/string/ustring.h"
+#include "core/templates/list.h"
+#include "core/templates/vector.h"
+
+namespace GDScriptTests {
+
+// Runs every script of a directory as a benchmark. Each script defines a
+// `benchmark()` function, called once per iteration, and optionally a
+// `setup()` function called once before timing starts.
+class GDScriptBenchmarkRunner {
+public:
+	struct Result {
+		String name;
+		int iterations = 0;
+		double ns_per_op = 0.0;
+		double allocs_per_op = 0.0; // Only measured on debug builds.
+		uint64_t opcodes_per_op = 0; // Only measured on debug builds.
+	};
+
+private:
+	String source_dir;
+	int iterations = 0;
+	bool do_init_languages = false;
+
+	bool make_benchmarks_for_dir(const String &p_dir, Vector<String> &r_paths) const;
+	bool run_benchmark(const String &p_path, Result &r_result) const;
+
+public:
+	static StringName benchmark_function_name;
+	static StringName setup_function_name;
+
+	static void handle_cmdline(const List<String> &p_args);
+
+	bool run(Vector<Result> &r_results);
+
+	static void print_results(const Vector<Result> &p_results);
+	static String results_to_json(const Vector<Result> &p_results);
+	// Prints the change of each benchmark relative to a JSON file written by `results_to_json()`.
+	// Returns the number of benchmarks that got slower than the given tolerance.
+	static int compare_to_baseline(const Vector<Result> &p_results, const String &p_baseline_path, double p_tolerance_percent);
+
+	GDScriptBenchmarkRunner(const String &p_source_dir, int p_iterations, bool p_init_language);
+	~GDScriptBenchmarkRunner();
+};
+
+} // namespace GDScriptTests
+
+#endif // GDSCRIPT_BENCHMARK_RUNNER_H
@@ -30,6 +30,8 @@
 
 #include "gdscript_test_runner.h"
 
+#include "gdscript_benchmark_runner.h"
+
 #include "../gdscript.h"
 #include "../gdscript_analyzer.h"
 #include "../gdscript_compiler.h"
@@ -366,6 +368,8 @@ void GDScriptTestRunner::handle_cmdline() {
 			bool completed = runner.generate_outputs();
 			int failed = completed ? 0 : -1;
 			exit(failed);
+		} else if (cmd == "--gdscript-benchmark") {
+			GDScriptBenchmarkRunner::handle_cmdline(cmdline_args);
 		}
 	}
 }
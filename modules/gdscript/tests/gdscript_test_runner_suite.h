@@ -31,8 +31,18 @@
 #ifndef GDSCRIPT_TEST_RUNNER_SUITE_H
 #define GDSCRIPT_TEST_RUNNER_SUITE_H
 
+#include "gdscript_benchmark_runner.h"
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_cache.h"
+#include "../gdscript_parser.h"
+#include "../gdscript_tokenizer_buffer.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
 #include "tests/test_macros.h"
 
 namespace GDScriptTests {
@@ -48,6 +58,14 @@ TEST_SUITE("[Modules][GDScript]") {
 		INFO("Make sure `*.out` files have expected results.");
 		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should pass.");
 	}
+
+	TEST_CASE("Benchmark scripts run") {
+		// Only checks that the benchmarks still work, timings are not meaningful here.
+		GDScriptBenchmarkRunner runner("modules/gdscript/tests/benchmarks", 1, true);
+		Vector<GDScriptBenchmarkRunner::Result> results;
+		REQUIRE_MESSAGE(runner.run(results), "All GDScript benchmarks should run.");
+		CHECK(results.size() > 0);
+	}
 }
 
 TEST_CASE("[Modules][GDScript] Load source code dynamically and run it") {
@@ -71,6 +89,381 @@ func _init():
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
 
+TEST_CASE("[Modules][GDScript] Load binary tokens and run them") {
+	const String source = R"(
+extends RefCounted
+
+func _init():
+	var values := [
+		1, 2,
+		3,
+	]
+	var total := 0
+	for value in values:
+		if value > 1:
+			total += value \
+					* 10
+	var add := func(a, b):
+		return a + b
+	set_meta("result", add.call(total, 1))
+)";
+	const Vector<uint8_t> buffer = GDScriptTokenizerBuffer::parse_code_string(source, GDScriptTokenizerBuffer::COMPRESS_ZSTD);
+	REQUIRE_MESSAGE(GDScriptTokenizerBuffer::is_token_buffer(buffer), "The source should be converted to binary tokens.");
+
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_binary_tokens_source(buffer);
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(error == OK, "The binary tokens should parse successfully.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 51, "The script loaded from binary tokens should behave like its source.");
+}
+
+TEST_CASE("[Modules][GDScript] Binary tokens report the same indentation errors as text") {
+	const String sources[] = {
+		"func f():\n\tif true:\n\t\tpass\n\t  pass\n", // Mixed tabs and spaces.
+		"func f():\n\tpass\nfunc g():\n    pass\n", // Spaces after tabs were used.
+		"func f():\n    if true:\n        pass\n      pass\n", // Unindent to an unknown level.
+	};
+
+	for (const String &source : sources) {
+		GDScriptParser text_parser;
+		ERR_PRINT_OFF;
+		text_parser.parse(source, "", false);
+		ERR_PRINT_ON;
+		REQUIRE_FALSE(text_parser.get_errors().is_empty());
+
+		const Vector<uint8_t> buffer = GDScriptTokenizerBuffer::parse_code_string(source, GDScriptTokenizerBuffer::COMPRESS_NONE);
+		REQUIRE(GDScriptTokenizerBuffer::is_token_buffer(buffer));
+		GDScriptParser binary_parser;
+		ERR_PRINT_OFF;
+		binary_parser.parse_binary(buffer, "");
+		ERR_PRINT_ON;
+		REQUIRE_FALSE(binary_parser.get_errors().is_empty());
+
+		CHECK_EQ(binary_parser.get_errors().front()->get().message, text_parser.get_errors().front()->get().message);
+		CHECK_EQ(binary_parser.get_errors().front()->get().line, text_parser.get_errors().front()->get().line);
+	}
+}
+
+TEST_CASE("[Modules][GDScript] Binary tokens keep the end line of multiline tokens") {
+	const Vector<uint8_t> buffer = GDScriptTokenizerBuffer::parse_code_string("var s = \"\"\"a\nb\"\"\" + \"c\"\nvar t\n", GDScriptTokenizerBuffer::COMPRESS_NONE);
+	GDScriptTokenizerBuffer tokenizer;
+	REQUIRE_EQ(tokenizer.set_code_buffer(buffer), OK);
+
+	GDScriptTokenizer::Token token = tokenizer.scan();
+	while (token.type != GDScriptTokenizer::Token::LITERAL) {
+		token = tokenizer.scan();
+	}
+	CHECK_EQ(token.start_line, 1);
+	CHECK_EQ(token.end_line, 2);
+
+	token = tokenizer.scan();
+	CHECK_EQ(token.type, GDScriptTokenizer::Token::PLUS);
+	CHECK_EQ(token.start_line, 2);
+
+	while (token.type != GDScriptTokenizer::Token::IDENTIFIER) {
+		token = tokenizer.scan();
+	}
+	CHECK_EQ(token.source, "t");
+	CHECK_EQ(token.start_line, 3);
+}
+
+TEST_CASE("[Modules][GDScript][SceneTree] Resume process_frame awaits in order") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends Node
+
+var events := []
+
+func wait(p_tag):
+	await get_tree().process_frame
+	events.append(p_tag)
+
+func wait_twice(p_tag):
+	await get_tree().process_frame
+	events.append(p_tag + "1")
+	await get_tree().process_frame
+	events.append(p_tag + "2")
+
+func on_process_frame():
+	events.append("signal")
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	SceneTree *tree = SceneTree::get_singleton();
+	Node *node = memnew(Node);
+	node->set_script(gdscript);
+	tree->get_root()->add_child(node);
+
+	node->call("wait", "a");
+	tree->connect(SNAME("process_frame"), Callable(node, "on_process_frame"));
+	node->call("wait_twice", "b");
+	node->call("wait", "c");
+
+	tree->process(0.1);
+
+	// Awaits resume together in the order they started, from the connection made by the first one.
+	Array expected;
+	expected.push_back("a");
+	expected.push_back("b1");
+	expected.push_back("c");
+	expected.push_back("signal");
+	CHECK(Array(node->get("events")) == expected);
+
+	// Awaiting again while being resumed waits for the next frame.
+	tree->process(0.1);
+	expected.push_back("b2");
+	expected.push_back("signal");
+	CHECK(Array(node->get("events")) == expected);
+
+	memdelete(node);
+}
+
+TEST_CASE("[Modules][GDScript][SceneTree] Failing to await after resuming frees the function's locals") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends Node
+
+func run(p_object):
+	var held = p_object
+	await get_tree().process_frame
+	await Signal(self, "missing_signal")
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	SceneTree *tree = SceneTree::get_singleton();
+	Node *node = memnew(Node);
+	node->set_script(gdscript);
+	tree->get_root()->add_child(node);
+
+	ObjectID held_id;
+	{
+		Ref<RefCounted> held = memnew(RefCounted);
+		held_id = held->get_instance_id();
+		node->call("run", held);
+	}
+	CHECK_MESSAGE(ObjectDB::get_instance(held_id) != nullptr, "The awaiting function should keep its locals.");
+
+	// Resumes on the stack saved by the first await, then fails to connect to the missing signal.
+	ERR_PRINT_OFF;
+	tree->process(0.1);
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(ObjectDB::get_instance(held_id) == nullptr, "The locals should be freed when the await fails.");
+
+	memdelete(node);
+}
+
+TEST_CASE("[Modules][GDScript][SceneTree] Process thread-safe scripts in automatic thread groups") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+@thread_safe
+extends Node
+
+func _process(_delta):
+	set_meta("thread", OS.get_thread_caller_id())
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+	REQUIRE_MESSAGE(gdscript->is_thread_safe(), "The script should be marked as thread-safe.");
+
+	SceneTree *tree = SceneTree::get_singleton();
+	tree->set_auto_process_thread_groups(true);
+
+	Node *parent = memnew(Node);
+	parent->set_script(gdscript);
+	Node *child = memnew(Node);
+	child->set_script(gdscript);
+	Node *sibling = memnew(Node);
+	sibling->set_script(gdscript);
+
+	tree->get_root()->add_child(parent);
+	parent->add_child(child);
+	tree->get_root()->add_child(sibling);
+
+	tree->process(0.1);
+
+	SUBCASE("All thread-safe nodes are processed") {
+		CHECK(parent->has_meta("thread"));
+		CHECK(child->has_meta("thread"));
+		CHECK(sibling->has_meta("thread"));
+	}
+
+	SUBCASE("A node is never batched with its ancestors") {
+		// Nodes are processed in tree order, so the child closes the parent's batch and starts
+		// a new one with the sibling. A batch made of a single node runs on the calling thread.
+		CHECK(uint64_t(parent->get_meta("thread")) == uint64_t(Thread::get_main_id()));
+	}
+
+	SUBCASE("Disabling automatic thread groups processes everything on the main thread") {
+		tree->set_auto_process_thread_groups(false);
+		tree->process(0.1);
+		CHECK(uint64_t(parent->get_meta("thread")) == uint64_t(Thread::get_main_id()));
+		CHECK(uint64_t(sibling->get_meta("thread")) == uint64_t(Thread::get_main_id()));
+	}
+
+	memdelete(sibling);
+	memdelete(parent);
+	tree->set_auto_process_thread_groups(false);
+}
+
+TEST_CASE("[Modules][GDScript][SceneTree] Automatic thread groups may only access their own subtree") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+@thread_safe
+extends Node
+
+var own_child: Node
+var other_child: Node
+
+func _process(_delta):
+	if own_child:
+		own_child.set_editor_description("touched")
+	if other_child:
+		other_child.set_editor_description("touched")
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+	SceneTree *tree = SceneTree::get_singleton();
+	tree->set_auto_process_thread_groups(true);
+
+	// Two unrelated thread-safe nodes, so they are batched together and processed on worker threads.
+	Node *first = memnew(Node);
+	first->set_script(gdscript);
+	Node *first_child = memnew(Node);
+	first->add_child(first_child);
+	Node *second = memnew(Node);
+	second->set_script(gdscript);
+	Node *second_child = memnew(Node);
+	second->add_child(second_child);
+
+	tree->get_root()->add_child(first);
+	tree->get_root()->add_child(second);
+	first->set("own_child", first_child);
+	first->set("other_child", second_child);
+
+	ERR_PRINT_OFF;
+	tree->process(0.1);
+	ERR_PRINT_ON;
+
+	CHECK_MESSAGE(first_child->get_editor_description() == "touched", "A node should be able to access its own descendants.");
+	CHECK_MESSAGE(second_child->get_editor_description().is_empty(), "A node should not be able to access another subtree.");
+
+	memdelete(second);
+	memdelete(first);
+	tree->set_auto_process_thread_groups(false);
+}
+
+TEST_CASE("[Modules][GDScript] Find and parse scripts exported as remapped binary tokens") {
+	const String dir = OS::get_singleton()->get_cache_path().path_join("gdscript_remap_test");
+	DirAccess::make_dir_recursive_absolute(dir);
+	const String script_path = dir.path_join("exported.gd");
+
+	// Mimic an exported project, where only the binary tokens and the remap are in the pack.
+	const Vector<uint8_t> buffer = GDScriptTokenizerBuffer::parse_code_string("extends RefCounted\nfunc value():\n\treturn 42\n", GDScriptTokenizerBuffer::COMPRESS_NONE);
+	Ref<FileAccess> f = FileAccess::open(dir.path_join("exported.gdc"), FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_buffer(buffer.ptr(), buffer.size());
+	f.unref();
+	f = FileAccess::open(script_path + ".remap", FileAccess::WRITE);
+	REQUIRE(f.is_valid());
+	f->store_string("[remap]\n\npath=\"" + dir.path_join("exported.gdc") + "\"\n");
+	f.unref();
+
+	CHECK_FALSE(FileAccess::exists(script_path));
+	CHECK_MESSAGE(GDScriptCache::script_file_exists(script_path), "The remapped binary tokens should be found for the script path.");
+	CHECK_FALSE(GDScriptCache::script_file_exists(dir.path_join("missing.gd")));
+
+	Error err = OK;
+	Ref<GDScriptParserRef> parser_ref = GDScriptCache::get_parser(script_path, GDScriptParserRef::PARSED, err);
+	CHECK_MESSAGE(err == OK, "The remapped binary tokens should parse successfully.");
+	parser_ref.unref();
+
+	DirAccess::remove_absolute(script_path + ".remap");
+	DirAccess::remove_absolute(dir.path_join("exported.gdc"));
+	DirAccess::remove_absolute(dir);
+}
+
+TEST_CASE("[Modules][GDScript] Parse the dependencies of a script ahead of its analysis") {
+	const String dir = OS::get_singleton()->get_cache_path().path_join("gdscript_dependencies_test");
+	DirAccess::make_dir_recursive_absolute(dir);
+
+	// Two levels of dependencies, with one script shared by both branches.
+	const String sources[4][2] = {
+		{ "main.gd", "extends RefCounted\nconst A = preload(\"dep_a.gd\")\nconst B = preload(\"dep_b.gd\")\nfunc value():\n\treturn A.new().value() + B.new().value()\n" },
+		{ "dep_a.gd", "extends RefCounted\nconst C = preload(\"dep_c.gd\")\nfunc value():\n\treturn 1 + C.new().value()\n" },
+		{ "dep_b.gd", "extends RefCounted\nconst C = preload(\"dep_c.gd\")\nfunc value():\n\treturn 10 + C.new().value()\n" },
+		{ "dep_c.gd", "extends RefCounted\nfunc value():\n\treturn 100\n" },
+	};
+	for (const String(&E)[2] : sources) {
+		Ref<FileAccess> f = FileAccess::open(dir.path_join(E[0]), FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(E[1]);
+	}
+	const String main_path = dir.path_join("main.gd");
+
+	SUBCASE("Dependencies are found from the parse alone") {
+		Error err = OK;
+		Ref<GDScriptParserRef> parser_ref = GDScriptCache::get_parser(main_path, GDScriptParserRef::PARSED, err);
+		REQUIRE(err == OK);
+		List<String> dependencies = parser_ref->get_parser()->get_dependencies();
+		CHECK(dependencies.size() == 2);
+		CHECK(dependencies.find(dir.path_join("dep_a.gd")) != nullptr);
+		CHECK(dependencies.find(dir.path_join("dep_b.gd")) != nullptr);
+	}
+
+	SUBCASE("Scripts compile with their dependencies parsed on the workers") {
+		Error err = OK;
+		Ref<GDScript> script = GDScriptCache::get_full_script(main_path, err);
+		REQUIRE(err == OK);
+		REQUIRE(script.is_valid());
+		Ref<RefCounted> instance = script->call("new");
+		CHECK(int(instance->call("value")) == 211);
+	}
+
+	SUBCASE("Scripts compile from a worker thread, as threaded loads do") {
+		struct LoadData {
+			String path;
+			Error err = FAILED;
+			int value = 0;
+		} data;
+		data.path = main_path;
+
+		WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task([](void *p_userdata) {
+			LoadData *load = static_cast<LoadData *>(p_userdata);
+			Ref<GDScript> script = GDScriptCache::get_full_script(load->path, load->err);
+			if (load->err == OK) {
+				Ref<RefCounted> instance = script->call("new");
+				load->value = instance->call("value");
+			}
+		},
+				&data);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+		CHECK(data.err == OK);
+		CHECK(data.value == 211);
+	}
+
+	for (const String(&E)[2] : sources) {
+		GDScriptCache::remove_script(dir.path_join(E[0]));
+		DirAccess::remove_absolute(dir.path_join(E[0]));
+	}
+	DirAccess::remove_absolute(dir);
+}
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
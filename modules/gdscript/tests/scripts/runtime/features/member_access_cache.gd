@@ -0,0 +1,47 @@
+# Member access on other instances goes through a per-instruction cache keyed on the script.
+
+class Entity:
+	var hp: int = 10
+	var speed: float = 1.5
+	var tag = "none"
+	var guarded: int = 0:
+		set(value):
+			guarded = clampi(value, 0, 5)
+
+class Player extends Entity:
+	var score := 0
+
+func bump(entity):
+	entity.hp += 1
+	entity.tag = "bumped"
+	return entity.hp
+
+func test():
+	var typed := Entity.new()
+	for i in 3:
+		typed.hp += 2
+	print(typed.hp)
+
+	# Same instruction, different classes and a non-script object.
+	var untyped: Array = [Entity.new(), Player.new(), Entity.new()]
+	for e in untyped:
+		print(bump(e), " ", e.tag)
+	var node := Node.new()
+	node.name = "plain"
+	print(node.name)
+	node.free()
+
+	# Values of another type are still converted to the member type.
+	for value in [3, 4.5]:
+		typed.speed = value
+		print(typed.speed, " ", type_string(typeof(typed.speed)))
+
+	# Setters still run.
+	for value in [3, 9, -2]:
+		typed.guarded = value
+		print(typed.guarded)
+
+	var player := Player.new()
+	player.score = 7
+	player.hp = 1
+	print(player.score + player.hp)
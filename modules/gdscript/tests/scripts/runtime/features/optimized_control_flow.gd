@@ -0,0 +1,39 @@
+# Constant branches and unreachable statements are not compiled,
+# and operator results are written straight into typed locals.
+
+const ENABLED = false
+
+func pick(value: int) -> int:
+	if ENABLED:
+		return -1
+	elif value > 2:
+		return value * 2
+	return value
+	print("unreachable")
+
+func test():
+	if true:
+		print("constant true branch")
+	else:
+		print("not compiled")
+
+	while false:
+		print("not compiled")
+
+	print(pick(1), " ", pick(5))
+
+	var a: int = 3
+	a = a * a + a
+	var b: int = a - 1
+	var half: float = float(b) / 2.0
+	var mid: Vector2 = Vector2(a, b) * half
+	print(a, " ", b, " ", half, " ", mid)
+
+	# Results that flow through a conditional still go through a temporary.
+	var c: int = a + 1 if b > 10 else a - 1
+	var d: int = 0
+	for i in 3:
+		d = d + i * c
+		if d > 100:
+			break
+	print(c, " ", d)
@@ -0,0 +1,27 @@
+func test():
+	var a := PackedFloat32Array([1.0, 2.0, 3.0, 4.0])
+	a.scale(2.0)
+	print(a)
+	a.offset(1.0)
+	print(a)
+	print(a.sum())
+	print(a.min())
+	print(a.max())
+	print(a.dot(PackedFloat32Array([1.0, 0.0, 1.0, 0.0])))
+	print(a.lerp(PackedFloat32Array([0.0, 0.0, 0.0, 0.0]), 0.5))
+	print(a.select(PackedByteArray([0, 1, 0, 1]), PackedFloat32Array([0.0, 0.0, 0.0, 0.0])))
+
+	# Longer than one group of accumulators, with a remainder.
+	var b := PackedFloat32Array([5.0, -2.0, 7.0, 1.0, 3.0, 9.0, -4.0])
+	print(b.sum())
+	print(b.min())
+	print(b.max())
+	print(b.dot(b))
+	# Accumulated in double, the ones aren't lost next to 2^24.
+	print(PackedFloat32Array([16777216.0, 1.0, 1.0, 1.0, 1.0]).sum())
+
+	var v := PackedVector2Array([Vector2(1, 2), Vector2(3, 4)])
+	v.scale(0.5)
+	v.offset(Vector2(1, 1))
+	print(v)
+	print(v.sum())
@@ -0,0 +1,23 @@
+# Operators on operands statically typed as int or float use dedicated opcodes.
+
+func test():
+	var a: int = 7
+	var b: int = 3
+	var x: float = 2.5
+	var y: float = 0.5
+
+	print(a + b, " ", a - b, " ", a * b)
+	print(a == b, " ", a != b, " ", a < b, " ", a <= b, " ", a > b, " ", a >= b)
+	print(x + y, " ", x - y, " ", x * y, " ", x / y)
+	print(x == y, " ", x != y, " ", x < y, " ", x <= y, " ", x > y, " ", x >= y)
+
+	# Results can be stored back into one of the operands.
+	var total: int = 0
+	for i in 5:
+		total = total + i
+	a = a * a
+	x = x / y
+	print(total, " ", a, " ", x)
+
+	# Mixed operand types keep going through the generic evaluators.
+	print(a + x, " ", b * y)
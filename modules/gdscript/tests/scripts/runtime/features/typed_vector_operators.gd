@@ -0,0 +1,33 @@
+# Vector operators and same-type assignments of inline values use dedicated opcodes.
+
+func test():
+	var a: Vector2 = Vector2(3, 4)
+	var b: Vector2 = Vector2(1, 2)
+	var s: float = 0.5
+	print(a + b, " ", a - b, " ", a * b, " ", a * s, " ", a / s)
+
+	var c: Vector3 = Vector3(1, 2, 3)
+	var d: Vector3 = Vector3(2, 2, 2)
+	print(c + d, " ", c - d, " ", c * d, " ", c * s, " ", c / s)
+
+	# Accumulate into a typed local, like a movement integration step.
+	var position: Vector2 = Vector2.ZERO
+	var velocity: Vector2 = Vector2(2, -1)
+	for i in 4:
+		position = position + velocity * s
+	print(position)
+
+	var flag: bool = true
+	var other_flag: bool = flag
+	var count: int = 3
+	var other_count: int = count
+	var ratio: float = 0.25
+	var other_ratio: float = ratio
+	var point: Vector3 = c
+	point = d
+	print(other_flag, " ", other_count, " ", other_ratio, " ", point)
+
+	# The copy must not alias the source.
+	other_count += 1
+	point.x = 10
+	print(count, " ", other_count, " ", d, " ", point)
@@ -548,9 +548,13 @@ public:
 			// Only accessible if node is outside the scene tree
 			// or access will happen from a node-safe thread.
 			return !data.inside_tree || is_current_thread_safe_for_nodes();
-		} else {
+		} else if (current_process_thread_group == data.process_thread_group_owner) {
 			// Thread processing.
-			return current_process_thread_group == data.process_thread_group_owner;
+			return true;
+		} else {
+			// Automatic thread processing (the processed node is not a group owner),
+			// only the subtree of the processed node is accessible. Nodes in other groups may be processed concurrently.
+			return data.process_thread_group_owner == nullptr && (current_process_thread_group == this || current_process_thread_group->is_ancestor_of(this));
 		}
 	}
 
@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/trace_profiler.h"
 #include "core/input/input.h"
 #include "core/io/dir_access.h"
 #include "core/io/image_loader.h"
@@ -450,6 +451,8 @@ void SceneTree::initialize() {
 }
 
 bool SceneTree::physics_process(double p_time) {
+	TRACE_SCOPE("SceneTree::physics_process");
+
 	root_lock++;
 
 	current_frame++;
@@ -484,6 +487,8 @@ bool SceneTree::physics_process(double p_time) {
 }
 
 bool SceneTree::process(double p_time) {
+	TRACE_SCOPE("SceneTree::process");
+
 	root_lock++;
 
 	if (MainLoop::process(p_time)) {
@@ -892,7 +897,43 @@ bool SceneTree::is_paused() const {
 	return paused;
 }
 
+void SceneTree::_process_node(Node *p_node, bool p_physics) {
+	if (p_physics) {
+		if (p_node->is_physics_processing_internal()) {
+			p_node->notification(Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
+		}
+		if (p_node->is_physics_processing()) {
+			p_node->notification(Node::NOTIFICATION_PHYSICS_PROCESS);
+		}
+	} else {
+		if (p_node->is_processing_internal()) {
+			p_node->notification(Node::NOTIFICATION_INTERNAL_PROCESS);
+		}
+		if (p_node->is_processing()) {
+			p_node->notification(Node::NOTIFICATION_PROCESS);
+		}
+	}
+}
+
+bool SceneTree::_is_node_auto_threadable(Node *p_node, bool p_physics) const {
+	// Internal processing is engine code that may reach outside of the node's subtree,
+	// so only nodes doing nothing but script processing are eligible.
+	if (p_physics ? p_node->is_physics_processing_internal() : p_node->is_processing_internal()) {
+		return false;
+	}
+
+	ScriptInstance *si = p_node->get_script_instance();
+	if (si == nullptr) {
+		return false;
+	}
+
+	Ref<Script> scr = si->get_script();
+	return scr.is_valid() && scr->is_thread_safe();
+}
+
 void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
+	TRACE_SCOPE("SceneTree::process_group");
+
 	// When reading this function, keep in mind that this code must work in a way where
 	// if any node is removed, this needs to continue working.
 
@@ -921,6 +962,14 @@ void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
 	uint32_t node_count = nodes_copy.size();
 	Node **nodes_ptr = (Node **)nodes_copy.ptr(); // Force cast, pointer will not change.
 
+	// Automatic thread groups only split the main thread group, explicit sub-thread groups are already threaded.
+	bool auto_threads = auto_process_thread_groups && !node_threading_disabled && p_group == &default_process_group;
+	int auto_priority = 0;
+	if (auto_threads) {
+		// Only the main thread processes the default group, so this is not shared with sub-thread groups.
+		_clear_auto_batch();
+	}
+
 	for (uint32_t i = 0; i < node_count; i++) {
 		Node *n = nodes_ptr[i];
 		if (nodes_removed_on_group_call.has(n)) {
@@ -933,21 +982,28 @@ void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
 			continue;
 		}
 
-		if (p_physics) {
-			if (n->is_physics_processing_internal()) {
-				n->notification(Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
-			}
-			if (n->is_physics_processing()) {
-				n->notification(Node::NOTIFICATION_PHYSICS_PROCESS);
-			}
-		} else {
-			if (n->is_processing_internal()) {
-				n->notification(Node::NOTIFICATION_INTERNAL_PROCESS);
+		if (auto_threads) {
+			// Consecutive thread-safe nodes with the same priority are batched and run in parallel.
+			// Any other node acts as a barrier, so the relative order with non thread-safe nodes is kept.
+			int priority = p_physics ? n->get_physics_process_priority() : n->get_process_priority();
+			bool threadable = _is_node_auto_threadable(n, p_physics);
+
+			if (!local_auto_process_cache.is_empty() && (!threadable || priority != auto_priority || _is_related_to_auto_batch(n))) {
+				_process_auto_batch(p_physics);
 			}
-			if (n->is_processing()) {
-				n->notification(Node::NOTIFICATION_PROCESS);
+
+			if (threadable) {
+				auto_priority = priority;
+				_add_to_auto_batch(n);
+				continue;
 			}
 		}
+
+		_process_node(n, p_physics);
+	}
+
+	if (auto_threads && !local_auto_process_cache.is_empty()) {
+		_process_auto_batch(p_physics);
 	}
 
 	p_group->call_queue.flush(); // Flush messages also after processing (for potential deferred calls).
@@ -959,6 +1015,53 @@ void SceneTree::_process_groups_thread(uint32_t p_index, bool p_physics) {
 	Node::current_process_thread_group = nullptr;
 }
 
+bool SceneTree::_is_related_to_auto_batch(Node *p_node) const {
+	// A node and any of its ancestors or descendants must never be processed concurrently.
+	if (local_auto_process_ancestors.has(p_node)) {
+		return true;
+	}
+	for (Node *p = p_node->get_parent(); p; p = p->get_parent()) {
+		if (local_auto_process_nodes.has(p)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void SceneTree::_add_to_auto_batch(Node *p_node) {
+	local_auto_process_cache.push_back(p_node);
+	local_auto_process_nodes.insert(p_node);
+	for (Node *p = p_node->get_parent(); p; p = p->get_parent()) {
+		local_auto_process_ancestors.insert(p);
+	}
+}
+
+void SceneTree::_clear_auto_batch() {
+	local_auto_process_cache.clear();
+	local_auto_process_nodes.clear();
+	local_auto_process_ancestors.clear();
+}
+
+void SceneTree::_process_auto_thread(uint32_t p_index, bool p_physics) {
+	// The node acts as the owner of an implicit group made of its subtree,
+	// see Node::is_accessible_from_caller_thread().
+	Node *n = local_auto_process_cache[p_index];
+	Node::current_process_thread_group = n;
+	_process_node(n, p_physics);
+	Node::current_process_thread_group = nullptr;
+}
+
+void SceneTree::_process_auto_batch(bool p_physics) {
+	if (local_auto_process_cache.size() == 1) {
+		// Not worth a task.
+		_process_node(local_auto_process_cache[0], p_physics);
+	} else {
+		WorkerThreadPool::GroupID id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTree::_process_auto_thread, p_physics, local_auto_process_cache.size(), -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(id);
+	}
+	_clear_auto_batch();
+}
+
 void SceneTree::_process(bool p_physics) {
 	if (process_groups_dirty) {
 		{
@@ -1606,6 +1709,9 @@ void SceneTree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_multiplayer_poll_enabled", "enabled"), &SceneTree::set_multiplayer_poll_enabled);
 	ClassDB::bind_method(D_METHOD("is_multiplayer_poll_enabled"), &SceneTree::is_multiplayer_poll_enabled);
 
+	ClassDB::bind_method(D_METHOD("set_auto_process_thread_groups", "enabled"), &SceneTree::set_auto_process_thread_groups);
+	ClassDB::bind_method(D_METHOD("is_auto_process_thread_groups_enabled"), &SceneTree::is_auto_process_thread_groups_enabled);
+
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "auto_accept_quit"), "set_auto_accept_quit", "is_auto_accept_quit");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "quit_on_go_back"), "set_quit_on_go_back", "is_quit_on_go_back");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "debug_collisions_hint"), "set_debug_collisions_hint", "is_debugging_collisions_hint");
@@ -1616,6 +1722,7 @@ void SceneTree::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "current_scene", PROPERTY_HINT_RESOURCE_TYPE, "Node", PROPERTY_USAGE_NONE), "set_current_scene", "get_current_scene");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "root", PROPERTY_HINT_RESOURCE_TYPE, "Node", PROPERTY_USAGE_NONE), "", "get_root");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "multiplayer_poll"), "set_multiplayer_poll_enabled", "is_multiplayer_poll_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "auto_process_thread_groups"), "set_auto_process_thread_groups", "is_auto_process_thread_groups_enabled");
 
 	ADD_SIGNAL(MethodInfo("tree_changed"));
 	ADD_SIGNAL(MethodInfo("tree_process_mode_changed")); //editor only signal, but due to API hash it can't be removed in run-time
@@ -1684,6 +1791,15 @@ void SceneTree::set_disable_node_threading(bool p_disable) {
 	node_threading_disabled = p_disable;
 }
 
+void SceneTree::set_auto_process_thread_groups(bool p_enabled) {
+	ERR_FAIL_COND_MSG(!Thread::is_main_thread(), "Automatic thread groups can only be toggled from the main thread.");
+	auto_process_thread_groups = p_enabled;
+}
+
+bool SceneTree::is_auto_process_thread_groups_enabled() const {
+	return auto_process_thread_groups;
+}
+
 SceneTree::SceneTree() {
 	if (singleton == nullptr) {
 		singleton = this;
@@ -1696,6 +1812,9 @@ SceneTree::SceneTree() {
 
 	GLOBAL_DEF("debug/shapes/collision/draw_2d_outlines", true);
 
+	const bool use_auto_process_thread_groups = GLOBAL_DEF("application/run/auto_process_thread_groups", false);
+	auto_process_thread_groups = use_auto_process_thread_groups && !Engine::get_singleton()->is_editor_hint();
+
 	process_group_call_queue_allocator = memnew(CallQueue::Allocator(64));
 	Math::randomize();
 
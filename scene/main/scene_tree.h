@@ -115,6 +115,11 @@ private:
 
 	bool node_threading_disabled = false;
 
+	bool auto_process_thread_groups = false;
+	LocalVector<Node *> local_auto_process_cache; // Thread-safe nodes of the default group being processed in parallel.
+	HashSet<Node *> local_auto_process_nodes; // Same nodes, for lookups.
+	HashSet<Node *> local_auto_process_ancestors; // Ancestors of those nodes.
+
 	struct Group {
 		Vector<Node *> nodes;
 		bool changed = false;
@@ -215,8 +220,15 @@ private:
 	void remove_from_group(const StringName &p_group, Node *p_node);
 	void make_group_changed(const StringName &p_group);
 
+	_FORCE_INLINE_ void _process_node(Node *p_node, bool p_physics);
+	_FORCE_INLINE_ bool _is_node_auto_threadable(Node *p_node, bool p_physics) const;
 	void _process_group(ProcessGroup *p_group, bool p_physics);
 	void _process_groups_thread(uint32_t p_index, bool p_physics);
+	bool _is_related_to_auto_batch(Node *p_node) const;
+	void _add_to_auto_batch(Node *p_node);
+	void _clear_auto_batch();
+	void _process_auto_thread(uint32_t p_index, bool p_physics);
+	void _process_auto_batch(bool p_physics);
 	void _process(bool p_physics);
 
 	void _remove_process_group(Node *p_node);
@@ -420,6 +432,9 @@ public:
 	static void add_idle_callback(IdleCallback p_callback);
 
 	void set_disable_node_threading(bool p_disable);
+
+	void set_auto_process_thread_groups(bool p_enabled);
+	bool is_auto_process_thread_groups_enabled() const;
 	//default texture settings
 
 	SceneTree();
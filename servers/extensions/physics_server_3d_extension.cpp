@@ -167,6 +167,9 @@ void PhysicsServer3DExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_space_get_contacts, "space");
 	GDVIRTUAL_BIND(_space_get_contact_count, "space");
 
+	GDVIRTUAL_BIND(_space_save_state, "space");
+	GDVIRTUAL_BIND(_space_restore_state, "space", "state");
+
 	/* AREA API */
 
 	GDVIRTUAL_BIND(_area_create);
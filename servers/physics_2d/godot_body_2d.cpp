@@ -32,6 +32,7 @@
 
 #include "godot_area_2d.h"
 #include "godot_body_direct_state_2d.h"
+#include "godot_deterministic_math_2d.h"
 #include "godot_space_2d.h"
 
 void GodotBody2D::_mass_properties_changed() {
@@ -560,7 +561,12 @@ void GodotBody2D::integrate_forces(real_t p_step) {
 		motion = new_transform.get_origin() - get_transform().get_origin();
 		linear_velocity = constant_linear_velocity + motion / p_step;
 
-		real_t rot = new_transform.get_rotation() - get_transform().get_rotation();
+		real_t rot;
+		if (get_space()->is_deterministic()) {
+			rot = GodotDeterministicMath2D::atan2(new_transform.columns[0].y, new_transform.columns[0].x) - GodotDeterministicMath2D::atan2(get_transform().columns[0].y, get_transform().columns[0].x);
+		} else {
+			rot = new_transform.get_rotation() - get_transform().get_rotation();
+		}
 		angular_velocity = constant_angular_velocity + remainder(rot, 2.0 * Math_PI) / p_step;
 
 		do_motion = true;
@@ -632,15 +638,37 @@ void GodotBody2D::integrate_velocities(real_t p_step) {
 	Vector2 total_linear_velocity = linear_velocity + biased_linear_velocity;
 
 	real_t angle_delta = total_angular_velocity * p_step;
-	real_t angle = get_transform().get_rotation() + angle_delta;
 	Vector2 pos = get_transform().get_origin() + total_linear_velocity * p_step;
+	Transform2D xform;
+
+	if (get_space()->is_deterministic()) {
+		// Rotate the current orientation by the step angle instead of going through
+		// atan2(), so only the sine and cosine of the (small) delta are needed.
+		double s;
+		double c;
+		GodotDeterministicMath2D::sin_cos(angle_delta, s, c);
+
+		const Vector2 dir = get_transform().columns[0].normalized();
+		xform.columns[0] = Vector2(dir.x * c - dir.y * s, dir.x * s + dir.y * c);
+		xform.columns[1] = Vector2(-xform.columns[0].y, xform.columns[0].x);
 
-	if (center_of_mass.length_squared() > CMP_EPSILON2) {
-		// Calculate displacement due to center of mass offset.
-		pos += center_of_mass - center_of_mass.rotated(angle_delta);
+		if (center_of_mass.length_squared() > CMP_EPSILON2) {
+			// Calculate displacement due to center of mass offset.
+			pos += center_of_mass - Vector2(center_of_mass.x * c - center_of_mass.y * s, center_of_mass.x * s + center_of_mass.y * c);
+		}
+		xform.columns[2] = pos;
+	} else {
+		real_t angle = get_transform().get_rotation() + angle_delta;
+
+		if (center_of_mass.length_squared() > CMP_EPSILON2) {
+			// Calculate displacement due to center of mass offset.
+			pos += center_of_mass - center_of_mass.rotated(angle_delta);
+		}
+
+		xform = Transform2D(angle, pos);
 	}
 
-	_set_transform(Transform2D(angle, pos), continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED);
+	_set_transform(xform, continuous_cd_mode == PhysicsServer2D::CCD_MODE_DISABLED);
 	_set_inv_transform(get_transform().inverse());
 
 	if (continuous_cd_mode != PhysicsServer2D::CCD_MODE_DISABLED) {
@@ -717,6 +745,37 @@ bool GodotBody2D::sleep_test(real_t p_step) {
 	}
 }
 
+void GodotBody2D::save_snapshot(Snapshot &r_snapshot) const {
+	// Snapshots are compared and copied as raw bytes, so padding and unused fields must be zeroed.
+	memset((void *)&r_snapshot, 0, sizeof(Snapshot));
+	r_snapshot.self = get_self();
+	r_snapshot.transform = get_transform();
+	r_snapshot.inv_transform = get_inv_transform();
+	r_snapshot.new_transform = new_transform;
+	r_snapshot.linear_velocity = linear_velocity;
+	r_snapshot.angular_velocity = angular_velocity;
+	r_snapshot.prev_linear_velocity = prev_linear_velocity;
+	r_snapshot.prev_angular_velocity = prev_angular_velocity;
+	r_snapshot.still_time = still_time;
+	r_snapshot.active = active;
+}
+
+void GodotBody2D::restore_snapshot(const Snapshot &p_snapshot) {
+	if (get_transform() != p_snapshot.transform) {
+		// Only bodies that actually moved need their broadphase entries updated.
+		_set_transform(p_snapshot.transform);
+		_set_inv_transform(p_snapshot.inv_transform);
+		_update_transform_dependent();
+	}
+
+	new_transform = p_snapshot.new_transform;
+	linear_velocity = p_snapshot.linear_velocity;
+	angular_velocity = p_snapshot.angular_velocity;
+	prev_linear_velocity = p_snapshot.prev_linear_velocity;
+	prev_angular_velocity = p_snapshot.prev_angular_velocity;
+	still_time = p_snapshot.still_time;
+}
+
 void GodotBody2D::set_state_sync_callback(const Callable &p_callable) {
 	body_state_callback = p_callable;
 }
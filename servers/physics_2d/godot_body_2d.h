@@ -336,6 +336,24 @@ public:
 
 	bool sleep_test(real_t p_step);
 
+	// Simulation state saved and restored by space snapshots. Activation is left to the space,
+	// which has to keep the active list in order.
+	struct Snapshot {
+		RID self;
+		Transform2D transform;
+		Transform2D inv_transform;
+		Transform2D new_transform;
+		Vector2 linear_velocity;
+		real_t angular_velocity = 0.0;
+		Vector2 prev_linear_velocity;
+		real_t prev_angular_velocity = 0.0;
+		real_t still_time = 0.0;
+		bool active = false;
+	};
+
+	void save_snapshot(Snapshot &r_snapshot) const;
+	void restore_snapshot(const Snapshot &p_snapshot);
+
 	GodotBody2D();
 	~GodotBody2D();
 };
@@ -591,6 +591,43 @@ void GodotBodyPair2D::solve(real_t p_step) {
 	}
 }
 
+GodotBodyPair2D::SnapshotKey GodotBodyPair2D::get_snapshot_key() const {
+	SnapshotKey key;
+	key.body_A = A->get_self();
+	key.body_B = B->get_self();
+	key.shape_A = shape_A;
+	key.shape_B = shape_B;
+	return key;
+}
+
+void GodotBodyPair2D::save_snapshot(Snapshot &r_snapshot) const {
+	// Snapshots are compared and copied as raw bytes, so padding and unused fields must be zeroed.
+	memset((void *)&r_snapshot, 0, sizeof(Snapshot));
+	r_snapshot.key = get_snapshot_key();
+	r_snapshot.sep_axis = sep_axis;
+	r_snapshot.contact_count = contact_count;
+	r_snapshot.oneway_disabled = oneway_disabled;
+	for (int i = 0; i < contact_count; i++) {
+		r_snapshot.contacts[i] = contacts[i];
+	}
+}
+
+void GodotBodyPair2D::restore_snapshot(const Snapshot &p_snapshot) {
+	sep_axis = p_snapshot.sep_axis;
+	contact_count = CLAMP(p_snapshot.contact_count, 0, (int)MAX_CONTACTS);
+	oneway_disabled = p_snapshot.oneway_disabled;
+	for (int i = 0; i < contact_count; i++) {
+		contacts[i] = p_snapshot.contacts[i];
+	}
+}
+
+void GodotBodyPair2D::clear_snapshot() {
+	// Same as a newly created pair.
+	sep_axis = Vector2();
+	contact_count = 0;
+	oneway_disabled = false;
+}
+
 GodotBodyPair2D::GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p_B, int p_shape_B) :
 		GodotConstraint2D(_arr, 2) {
 	A = p_A;
@@ -34,6 +34,8 @@
 #include "godot_body_2d.h"
 #include "godot_constraint_2d.h"
 
+#include "core/templates/hashfuncs.h"
+
 class GodotBodyPair2D : public GodotConstraint2D {
 	enum {
 		MAX_CONTACTS = 2
@@ -94,6 +96,42 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual GodotBodyPair2D *get_body_pair() override { return this; }
+
+	struct SnapshotKey {
+		RID body_A;
+		RID body_B;
+		int shape_A = 0;
+		int shape_B = 0;
+
+		static uint32_t hash(const SnapshotKey &p_key) {
+			uint32_t h = hash_murmur3_one_64(p_key.body_A.get_id());
+			h = hash_murmur3_one_64(p_key.body_B.get_id(), h);
+			h = hash_murmur3_one_32(p_key.shape_A, h);
+			h = hash_murmur3_one_32(p_key.shape_B, h);
+			return hash_fmix32(h);
+		}
+
+		bool operator==(const SnapshotKey &p_key) const {
+			return body_A == p_key.body_A && body_B == p_key.body_B && shape_A == p_key.shape_A && shape_B == p_key.shape_B;
+		}
+	};
+
+	// Contact cache saved and restored by space snapshots, so that the solver keeps
+	// its warm start data after a rollback.
+	struct Snapshot {
+		SnapshotKey key;
+		Vector2 sep_axis;
+		int contact_count = 0;
+		bool oneway_disabled = false;
+		Contact contacts[MAX_CONTACTS];
+	};
+
+	SnapshotKey get_snapshot_key() const;
+	void save_snapshot(Snapshot &r_snapshot) const;
+	void restore_snapshot(const Snapshot &p_snapshot);
+	void clear_snapshot();
+
 	GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p_B, int p_shape_B);
 	~GodotBodyPair2D();
 };
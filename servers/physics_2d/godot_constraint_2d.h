@@ -33,6 +33,8 @@
 
 #include "godot_body_2d.h"
 
+class GodotBodyPair2D;
+
 class GodotConstraint2D {
 	GodotBody2D **_body_ptr;
 	int _body_count;
@@ -64,6 +66,8 @@ public:
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
 
+	virtual GodotBodyPair2D *get_body_pair() { return nullptr; }
+
 	virtual ~GodotConstraint2D() {}
 };
 
@@ -0,0 +1,245 @@
+/**************************************************************************/
+/*  godot_deterministic_math_2d.cpp                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "godot_deterministic_math_2d.h"
+
+// Every multiply and add below must be rounded on its own, whatever the build
+// options, since fusing them into FMAs changes the results on some CPUs only.
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#elif defined(_MSC_VER)
+#pragma fp_contract(off)
+#endif
+
+// pi/2 split into three parts (Cody-Waite), the first one with enough
+// trailing zero bits for k * PIO2_1 to be exact for any reasonable angle.
+#define PIO2_1 1.57079632673412561417e+00
+#define PIO2_2 6.07710050630396597660e-11
+#define PIO2_3 2.02226624879595063154e-21
+#define TWO_OVER_PI 6.36619772367581382433e-01
+
+// ln(2) split the same way for exp().
+#define LN2_HI 6.93147180369123816490e-01
+#define LN2_LO 1.90821492927058770002e-10
+#define INV_LN2 1.44269504088896338700e+00
+
+// Beyond these, exp() overflows to infinity or underflows to zero.
+#define EXP_OVERFLOW 7.09782712893383973096e+02
+#define EXP_UNDERFLOW -7.45133219101941108420e+02
+
+// Constants that atan() results are added to, as the nearest double plus
+// the rounding error, so that the sum is only rounded once.
+#define ATAN_HALF_HI 4.63647609000806093515e-01
+#define ATAN_HALF_LO 2.26987774529616870924e-17
+#define PIO4_HI 7.85398163397448278999e-01
+#define PIO4_LO 3.06161699786838301793e-17
+#define PIO2_HI 1.57079632679489655800e+00
+#define PIO2_LO 6.12323399573676603587e-17
+#define PI_HI 3.14159265358979311600e+00
+#define PI_LO 1.22464679914735317720e-16
+
+// Enough terms for double precision over |x| <= 7/16.
+#define ATAN_SERIES_TERMS 24
+
+double GodotDeterministicMath2D::_sin_kernel(double p_x) {
+	// Taylor series, accurate to double precision over |x| <= pi/4.
+	const double x2 = p_x * p_x;
+	double r = 1.0 / 121645100408832000.0; // 1/19!
+	r = r * -x2 + 1.0 / 355687428096000.0; // 1/17!
+	r = r * -x2 + 1.0 / 1307674368000.0; // 1/15!
+	r = r * -x2 + 1.0 / 6227020800.0; // 1/13!
+	r = r * -x2 + 1.0 / 39916800.0; // 1/11!
+	r = r * -x2 + 1.0 / 362880.0; // 1/9!
+	r = r * -x2 + 1.0 / 5040.0; // 1/7!
+	r = r * -x2 + 1.0 / 120.0; // 1/5!
+	r = r * -x2 + 1.0 / 6.0; // 1/3!
+	return p_x - p_x * x2 * r;
+}
+
+double GodotDeterministicMath2D::_cos_kernel(double p_x) {
+	// Taylor series, accurate to double precision over |x| <= pi/4.
+	const double x2 = p_x * p_x;
+	double r = 1.0 / 2432902008176640000.0; // 1/20!
+	r = r * -x2 + 1.0 / 6402373705728000.0; // 1/18!
+	r = r * -x2 + 1.0 / 20922789888000.0; // 1/16!
+	r = r * -x2 + 1.0 / 87178291200.0; // 1/14!
+	r = r * -x2 + 1.0 / 479001600.0; // 1/12!
+	r = r * -x2 + 1.0 / 3628800.0; // 1/10!
+	r = r * -x2 + 1.0 / 40320.0; // 1/8!
+	r = r * -x2 + 1.0 / 720.0; // 1/6!
+	r = r * -x2 + 1.0 / 24.0; // 1/4!
+	r = r * -x2 + 0.5; // 1/2!
+	return 1.0 - x2 * r;
+}
+
+double GodotDeterministicMath2D::_reduce_half_pi(double p_x, int &r_quadrant) {
+	const double k = Math::floor(p_x * TWO_OVER_PI + 0.5);
+	// Exact for |k| < 2^53, avoids converting huge values to an integer.
+	r_quadrant = (int)(k - 4.0 * Math::floor(k * 0.25));
+	return ((p_x - k * PIO2_1) - k * PIO2_2) - k * PIO2_3;
+}
+
+double GodotDeterministicMath2D::sin(double p_x) {
+	double s;
+	double c;
+	sin_cos(p_x, s, c);
+	return s;
+}
+
+double GodotDeterministicMath2D::cos(double p_x) {
+	double s;
+	double c;
+	sin_cos(p_x, s, c);
+	return c;
+}
+
+void GodotDeterministicMath2D::sin_cos(double p_x, double &r_sin, double &r_cos) {
+	if (unlikely(!Math::is_finite(p_x))) {
+		r_sin = NAN;
+		r_cos = NAN;
+		return;
+	}
+	if (Math::abs(p_x) < 7.450580596923828125e-09) {
+		// Below 2^-27, sin(x) rounds to x and cos(x) to 1. Also keeps the sign of zero.
+		r_sin = p_x;
+		r_cos = 1.0;
+		return;
+	}
+
+	int quadrant = 0;
+	const double r = _reduce_half_pi(p_x, quadrant);
+	const double s = _sin_kernel(r);
+	const double c = _cos_kernel(r);
+
+	switch (quadrant) {
+		case 0: {
+			r_sin = s;
+			r_cos = c;
+		} break;
+		case 1: {
+			r_sin = c;
+			r_cos = -s;
+		} break;
+		case 2: {
+			r_sin = -s;
+			r_cos = -c;
+		} break;
+		default: {
+			r_sin = -c;
+			r_cos = s;
+		} break;
+	}
+}
+
+double GodotDeterministicMath2D::_atan_unit(double p_x) {
+	// atan(x) for x in [0, 1]. Above 7/16, use atan(x) = atan(c) + atan((x - c) / (1 + c * x))
+	// with c = 1/2 or 1, so the series argument stays small.
+	int range = 0;
+	double t = p_x;
+	if (p_x >= 0.6875) {
+		range = 2;
+		t = (p_x - 1.0) / (p_x + 1.0);
+	} else if (p_x >= 0.4375) {
+		range = 1;
+		t = (2.0 * p_x - 1.0) / (2.0 + p_x);
+	}
+
+	const double t2 = t * t;
+	double r = 0.0;
+	for (int i = ATAN_SERIES_TERMS - 1; i >= 0; i--) {
+		const double term = 1.0 / (double)(2 * i + 1);
+		r = r * t2 + ((i & 1) ? -term : term);
+	}
+	switch (range) {
+		case 1:
+			return ATAN_HALF_HI + (t * r + ATAN_HALF_LO);
+		case 2:
+			return PIO4_HI + (t * r + PIO4_LO);
+		default:
+			return t * r;
+	}
+}
+
+double GodotDeterministicMath2D::atan2(double p_y, double p_x) {
+	if (unlikely(!Math::is_finite(p_y) || !Math::is_finite(p_x))) {
+		// Special values have exact results in every C runtime.
+		return Math::atan2(p_y, p_x);
+	}
+	if (p_x == 0.0 && p_y == 0.0) {
+		// Same as C: +-0 towards +0, +-pi towards -0.
+		const double a = signbit(p_x) ? PI_HI : 0.0;
+		return signbit(p_y) ? -a : a;
+	}
+
+	const double ax = Math::abs(p_x);
+	const double ay = Math::abs(p_y);
+	double a = ax >= ay ? _atan_unit(ay / ax) : PIO2_HI - (_atan_unit(ax / ay) - PIO2_LO);
+	if (p_x < 0.0) {
+		a = PI_HI - (a - PI_LO);
+	}
+	return signbit(p_y) ? -a : a;
+}
+
+double GodotDeterministicMath2D::exp(double p_x) {
+	if (unlikely(Math::is_nan(p_x))) {
+		return p_x;
+	}
+	if (p_x > EXP_OVERFLOW) {
+		return INFINITY;
+	}
+	if (p_x < EXP_UNDERFLOW) {
+		return 0.0;
+	}
+
+	// exp(x) = 2^k * exp(r), with |r| <= ln(2) / 2.
+	const double k = Math::floor(p_x * INV_LN2 + 0.5);
+	const double r = (p_x - k * LN2_HI) - k * LN2_LO;
+
+	double e = 1.0 / 87178291200.0; // 1/14!
+	e = e * r + 1.0 / 6227020800.0; // 1/13!
+	e = e * r + 1.0 / 479001600.0; // 1/12!
+	e = e * r + 1.0 / 39916800.0; // 1/11!
+	e = e * r + 1.0 / 3628800.0; // 1/10!
+	e = e * r + 1.0 / 362880.0; // 1/9!
+	e = e * r + 1.0 / 40320.0; // 1/8!
+	e = e * r + 1.0 / 5040.0; // 1/7!
+	e = e * r + 1.0 / 720.0; // 1/6!
+	e = e * r + 1.0 / 120.0; // 1/5!
+	e = e * r + 1.0 / 24.0; // 1/4!
+	e = e * r + 1.0 / 6.0; // 1/3!
+	e = e * r + 0.5; // 1/2!
+	e = e * r + 1.0;
+	e = e * r + 1.0;
+
+	// Scaling by a power of two is exact.
+	return ::ldexp(e, (int)k);
+}
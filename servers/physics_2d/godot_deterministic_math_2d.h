@@ -0,0 +1,54 @@
+/**************************************************************************/
+/*  godot_deterministic_math_2d.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_DETERMINISTIC_MATH_2D_H
+#define GODOT_DETERMINISTIC_MATH_2D_H
+
+#include "core/math/math_funcs.h"
+
+// Transcendental functions evaluated with basic IEEE 754 operations only
+// (add, multiply, divide, sqrt, floor), so they return bit-identical results
+// on every platform and C runtime, unlike the libm versions behind Math::.
+// Used by the 2D physics step when deterministic simulation is enabled.
+class GodotDeterministicMath2D {
+	static double _sin_kernel(double p_x);
+	static double _cos_kernel(double p_x);
+	static double _atan_unit(double p_x);
+	static double _reduce_half_pi(double p_x, int &r_quadrant);
+
+public:
+	static double sin(double p_x);
+	static double cos(double p_x);
+	static void sin_cos(double p_x, double &r_sin, double &r_cos);
+	static double atan2(double p_y, double p_x);
+	static double exp(double p_x);
+};
+
+#endif // GODOT_DETERMINISTIC_MATH_2D_H
@@ -30,6 +30,7 @@
 
 #include "godot_joints_2d.h"
 
+#include "godot_deterministic_math_2d.h"
 #include "godot_space_2d.h"
 
 //based on chipmunk joint constraints
@@ -407,7 +408,11 @@ bool GodotDampedSpringJoint2D::setup(real_t p_step) {
 	n_mass = 1.0f / k;
 
 	target_vrn = 0.0f;
-	v_coef = 1.0f - Math::exp(-damping * (p_step)*k);
+	if (A->get_space()->is_deterministic()) {
+		v_coef = 1.0f - GodotDeterministicMath2D::exp(-damping * (p_step)*k);
+	} else {
+		v_coef = 1.0f - Math::exp(-damping * (p_step)*k);
+	}
 
 	// Calculate spring force.
 	real_t f_spring = (rest_length - dist) * stiffness;
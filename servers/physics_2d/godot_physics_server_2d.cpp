@@ -276,6 +276,18 @@ int GodotPhysicsServer2D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+Vector<uint8_t> GodotPhysicsServer2D::space_save_state(RID p_space) const {
+	GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND_V(!space, Vector<uint8_t>());
+	return space->save_state();
+}
+
+bool GodotPhysicsServer2D::space_restore_state(RID p_space, const Vector<uint8_t> &p_state) {
+	GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND_V(!space, false);
+	return space->restore_state(p_state);
+}
+
 PhysicsDirectSpaceState2D *GodotPhysicsServer2D::space_get_direct_state(RID p_space) {
 	GodotSpace2D *space = space_owner.get_or_null(p_space);
 	ERR_FAIL_COND_V(!space, nullptr);
@@ -1199,6 +1199,157 @@ real_t GodotSpace2D::get_param(PhysicsServer2D::SpaceParameter p_param) const {
 	return 0;
 }
 
+// Snapshots are raw copies of the body and contact structs, so they can only be
+// restored by the same build that saved them. The header is used to check that.
+struct _SpaceSnapshotHeader2D {
+	static const uint32_t MAGIC = 0x32535047; // "GPS2"
+
+	uint32_t magic = MAGIC;
+	uint32_t real_size = sizeof(real_t);
+	uint32_t body_size = sizeof(GodotBody2D::Snapshot);
+	uint32_t pair_size = sizeof(GodotBodyPair2D::Snapshot);
+	uint32_t body_count = 0;
+	uint32_t pair_count = 0;
+};
+
+Vector<uint8_t> GodotSpace2D::save_state() const {
+	ERR_FAIL_COND_V_MSG(locked, Vector<uint8_t>(), "Space state can't be saved while the space is being stepped.");
+
+	// Active bodies come first and in order, so that restoring puts the active list back as it was
+	// and the bodies are solved in the same order as during the original simulation.
+	LocalVector<const GodotBody2D *> bodies;
+	const SelfList<GodotBody2D> *active_body = active_list.first();
+	while (active_body) {
+		bodies.push_back(active_body->self());
+		active_body = active_body->next();
+	}
+
+	LocalVector<const GodotBodyPair2D *> pairs;
+	for (const GodotCollisionObject2D *object : objects) {
+		if (object->get_type() != GodotCollisionObject2D::TYPE_BODY) {
+			continue;
+		}
+
+		const GodotBody2D *body = static_cast<const GodotBody2D *>(object);
+		if (!body->is_active()) {
+			bodies.push_back(body);
+		}
+
+		for (const Pair<GodotConstraint2D *, int> &E : body->get_constraint_list()) {
+			// Each pair is in the constraint map of both its bodies, only take it from A.
+			const GodotBodyPair2D *pair = E.first->get_body_pair();
+			if (pair && E.second == 0) {
+				pairs.push_back(pair);
+			}
+		}
+	}
+
+	_SpaceSnapshotHeader2D header;
+	header.body_count = bodies.size();
+	header.pair_count = pairs.size();
+
+	Vector<uint8_t> state;
+	state.resize(sizeof(header) + bodies.size() * sizeof(GodotBody2D::Snapshot) + pairs.size() * sizeof(GodotBodyPair2D::Snapshot));
+	uint8_t *w = state.ptrw();
+
+	memcpy(w, &header, sizeof(header));
+	w += sizeof(header);
+
+	for (const GodotBody2D *body : bodies) {
+		GodotBody2D::Snapshot snapshot;
+		body->save_snapshot(snapshot);
+		memcpy(w, &snapshot, sizeof(snapshot));
+		w += sizeof(snapshot);
+	}
+
+	for (const GodotBodyPair2D *pair : pairs) {
+		GodotBodyPair2D::Snapshot snapshot;
+		pair->save_snapshot(snapshot);
+		memcpy(w, &snapshot, sizeof(snapshot));
+		w += sizeof(snapshot);
+	}
+
+	return state;
+}
+
+bool GodotSpace2D::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_V_MSG(locked, false, "Space state can't be restored while the space is being stepped.");
+	ERR_FAIL_COND_V(p_state.size() < (int)sizeof(_SpaceSnapshotHeader2D), false);
+
+	const uint8_t *r = p_state.ptr();
+
+	_SpaceSnapshotHeader2D header;
+	const _SpaceSnapshotHeader2D expected_header;
+	memcpy(&header, r, sizeof(header));
+	r += sizeof(header);
+
+	ERR_FAIL_COND_V_MSG(header.magic != expected_header.magic || header.real_size != expected_header.real_size || header.body_size != expected_header.body_size || header.pair_size != expected_header.pair_size, false, "Space state was saved by an incompatible build.");
+	ERR_FAIL_COND_V(p_state.size() != (int)(sizeof(header) + header.body_count * sizeof(GodotBody2D::Snapshot) + header.pair_count * sizeof(GodotBodyPair2D::Snapshot)), false);
+
+	HashMap<RID, GodotBody2D *> bodies_by_rid;
+	for (GodotCollisionObject2D *object : objects) {
+		if (object->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			bodies_by_rid.insert(object->get_self(), static_cast<GodotBody2D *>(object));
+		}
+	}
+
+	// Bodies that have been removed since the state was saved are skipped,
+	// and bodies that have been added since keep their current state.
+	LocalVector<GodotBody2D *> active_bodies;
+	for (uint32_t i = 0; i < header.body_count; i++) {
+		GodotBody2D::Snapshot snapshot;
+		memcpy(&snapshot, r, sizeof(snapshot));
+		r += sizeof(snapshot);
+
+		GodotBody2D **body = bodies_by_rid.getptr(snapshot.self);
+		if (!body) {
+			continue;
+		}
+
+		(*body)->restore_snapshot(snapshot);
+		(*body)->set_active(false);
+		if (snapshot.active) {
+			active_bodies.push_back(*body);
+		}
+	}
+
+	// Every restored body is out of the active list by now. Activating adds to the front
+	// of the list, so walk the saved order backwards to put the list back as it was.
+	for (int64_t i = (int64_t)active_bodies.size() - 1; i >= 0; i--) {
+		active_bodies[i]->set_active(true);
+	}
+
+	HashMap<GodotBodyPair2D::SnapshotKey, const uint8_t *, GodotBodyPair2D::SnapshotKey> pair_snapshots;
+	for (uint32_t i = 0; i < header.pair_count; i++) {
+		GodotBodyPair2D::SnapshotKey key;
+		memcpy(&key, r + offsetof(GodotBodyPair2D::Snapshot, key), sizeof(key));
+		pair_snapshots.insert(key, r);
+		r += sizeof(GodotBodyPair2D::Snapshot);
+	}
+
+	// Pairs are owned by the broadphase, so only the contacts of pairs that exist right now can be restored.
+	// Others start from an empty contact cache, as new pairs do.
+	for (const KeyValue<RID, GodotBody2D *> &E : bodies_by_rid) {
+		for (const Pair<GodotConstraint2D *, int> &C : E.value->get_constraint_list()) {
+			GodotBodyPair2D *pair = C.first->get_body_pair();
+			if (!pair || C.second != 0) {
+				continue;
+			}
+
+			const uint8_t *const *pair_snapshot = pair_snapshots.getptr(pair->get_snapshot_key());
+			if (pair_snapshot) {
+				GodotBodyPair2D::Snapshot snapshot;
+				memcpy(&snapshot, *pair_snapshot, sizeof(snapshot));
+				pair->restore_snapshot(snapshot);
+			} else {
+				pair->clear_snapshot();
+			}
+		}
+	}
+
+	return true;
+}
+
 void GodotSpace2D::lock() {
 	locked = true;
 }
@@ -1225,6 +1376,7 @@ GodotSpace2D::GodotSpace2D() {
 	contact_max_allowed_penetration = GLOBAL_GET("physics/2d/solver/contact_max_allowed_penetration");
 	contact_bias = GLOBAL_GET("physics/2d/solver/default_contact_bias");
 	constraint_bias = GLOBAL_GET("physics/2d/solver/default_constraint_bias");
+	deterministic = GLOBAL_GET("physics/2d/deterministic_simulation");
 
 	broadphase = GodotBroadPhase2D::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
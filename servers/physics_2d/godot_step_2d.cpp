@@ -30,6 +30,7 @@
 
 #include "godot_step_2d.h"
 
+#include "core/debugger/trace_profiler.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
@@ -126,6 +127,8 @@ void GodotStep2D::_check_suspend(LocalVector<GodotBody2D *> &p_body_island) cons
 }
 
 void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
+	TRACE_SCOPE("GodotStep2D::step");
+
 	p_space->lock(); // can't access space during this
 
 	p_space->setup(); //update inertias, etc
@@ -796,6 +796,37 @@ bool GodotBody3D::sleep_test(real_t p_step) {
 	}
 }
 
+void GodotBody3D::save_snapshot(Snapshot &r_snapshot) const {
+	// Snapshots are compared and copied as raw bytes, so padding and unused fields must be zeroed.
+	memset((void *)&r_snapshot, 0, sizeof(Snapshot));
+	r_snapshot.self = get_self();
+	r_snapshot.transform = get_transform();
+	r_snapshot.inv_transform = get_inv_transform();
+	r_snapshot.new_transform = new_transform;
+	r_snapshot.linear_velocity = linear_velocity;
+	r_snapshot.angular_velocity = angular_velocity;
+	r_snapshot.prev_linear_velocity = prev_linear_velocity;
+	r_snapshot.prev_angular_velocity = prev_angular_velocity;
+	r_snapshot.still_time = still_time;
+	r_snapshot.active = active;
+}
+
+void GodotBody3D::restore_snapshot(const Snapshot &p_snapshot) {
+	if (get_transform() != p_snapshot.transform) {
+		// Only bodies that actually moved need their broadphase entries updated.
+		_set_transform(p_snapshot.transform);
+		_set_inv_transform(p_snapshot.inv_transform);
+		_update_transform_dependent();
+	}
+
+	new_transform = p_snapshot.new_transform;
+	linear_velocity = p_snapshot.linear_velocity;
+	angular_velocity = p_snapshot.angular_velocity;
+	prev_linear_velocity = p_snapshot.prev_linear_velocity;
+	prev_angular_velocity = p_snapshot.prev_angular_velocity;
+	still_time = p_snapshot.still_time;
+}
+
 void GodotBody3D::set_state_sync_callback(const Callable &p_callable) {
 	body_state_callback = p_callable;
 }
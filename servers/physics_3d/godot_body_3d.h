@@ -217,7 +217,9 @@ public:
 	_FORCE_INLINE_ Vector3 get_prev_linear_velocity() const { return prev_linear_velocity; }
 	_FORCE_INLINE_ Vector3 get_prev_angular_velocity() const { return prev_angular_velocity; }
 
+	_FORCE_INLINE_ void set_biased_linear_velocity(const Vector3 &p_velocity) { biased_linear_velocity = p_velocity; }
 	_FORCE_INLINE_ const Vector3 &get_biased_linear_velocity() const { return biased_linear_velocity; }
+	_FORCE_INLINE_ void set_biased_angular_velocity(const Vector3 &p_velocity) { biased_angular_velocity = p_velocity; }
 	_FORCE_INLINE_ const Vector3 &get_biased_angular_velocity() const { return biased_angular_velocity; }
 
 	_FORCE_INLINE_ void apply_central_impulse(const Vector3 &p_impulse) {
@@ -343,6 +345,24 @@ public:
 
 	bool sleep_test(real_t p_step);
 
+	// Simulation state saved and restored by space snapshots. Activation is left to the space,
+	// which has to keep the active list in order.
+	struct Snapshot {
+		RID self;
+		Transform3D transform;
+		Transform3D inv_transform;
+		Transform3D new_transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		Vector3 prev_linear_velocity;
+		Vector3 prev_angular_velocity;
+		real_t still_time = 0.0;
+		bool active = false;
+	};
+
+	void save_snapshot(Snapshot &r_snapshot) const;
+	void restore_snapshot(const Snapshot &p_snapshot);
+
 	GodotBody3D();
 	~GodotBody3D();
 };
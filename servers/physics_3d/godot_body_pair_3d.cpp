@@ -163,13 +163,16 @@ void GodotBodyPair3D::validate_contacts() {
 
 // _test_ccd prevents tunneling by slowing down a high velocity body that is about to collide so that next frame it will be at an appropriate location to collide (i.e. slight overlap)
 // Warning: the way velocity is adjusted down to cause a collision means the momentum will be weaker than it should for a bounce!
-// Process: only proceed if body A's motion is high relative to its size.
-// cast forward along motion vector to see if A is going to enter/pass B's collider next frame, only proceed if it does.
+// Process: only proceed if body A's motion relative to B is high relative to its size.
+// sweep A's shape along the relative motion against B's shape to find the time of impact, only proceed if it happens this frame.
 // adjust the velocity of A down so that it will just slightly intersect the collider instead of blowing right past it.
+// Only A's own motion along the sweep is reduced, A is never sped up or pushed ahead of B when B is the one moving fast.
+// Rotation during the step is ignored.
 bool GodotBodyPair3D::_test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B) {
 	GodotShape3D *shape_A_ptr = p_A->get_shape(p_shape_A);
+	GodotShape3D *shape_B_ptr = p_B->get_shape(p_shape_B);
 
-	Vector3 motion = p_A->get_linear_velocity() * p_step;
+	Vector3 motion = (p_A->get_linear_velocity() - p_B->get_linear_velocity()) * p_step;
 	real_t mlen = motion.length();
 	if (mlen < CMP_EPSILON) {
 		return false;
@@ -180,72 +183,42 @@ bool GodotBodyPair3D::_test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A,
 	real_t min = 0.0, max = 0.0;
 	shape_A_ptr->project_range(mnormal, p_xform_A, min, max);
 
-	// Did it move enough in this direction to even attempt raycast?
+	// Did it move enough in this direction to even attempt a sweep?
 	// Let's say it should move more than 1/3 the size of the object in that axis.
 	bool fast_object = mlen > (max - min) * 0.3;
 	if (!fast_object) {
 		return false; // moving slow enough that there's no chance of tunneling.
 	}
 
-	// A is moving fast enough that tunneling might occur. See if it's really about to collide.
-
-	// Roughly predict body B's position in the next frame (ignoring collisions).
-	Transform3D predicted_xform_B = p_xform_B.translated(p_B->get_linear_velocity() * p_step);
-
-	// Support points are the farthest forward points on A in the direction of the motion vector.
-	// i.e. the candidate points of which one should hit B first if any collision does occur.
-	static const int max_supports = 16;
-	Vector3 supports_A[max_supports];
-	int support_count_A;
-	GodotShape3D::FeatureType support_type_A;
-	// Convert mnormal into body A's local xform because get_supports requires (and returns) local coordinates.
-	shape_A_ptr->get_supports(p_xform_A.basis.xform_inv(mnormal).normalized(), max_supports, supports_A, support_count_A, support_type_A);
-
-	// Cast a segment from each support point of A in the motion direction.
-	int segment_support_idx = -1;
-	float segment_hit_length = FLT_MAX;
-	Vector3 segment_hit_local;
-	for (int i = 0; i < support_count_A; i++) {
-		supports_A[i] = p_xform_A.xform(supports_A[i]);
-
-		Vector3 from = supports_A[i];
-		Vector3 to = from + motion;
-
-		Transform3D from_inv = predicted_xform_B.affine_inverse();
-
-		// Back up 10% of the per-frame motion behind the support point and use that as the beginning of our cast.
-		// At high speeds, this may mean we're actually casting from well behind the body instead of inside it, which is odd.
-		// But it still works out.
-		Vector3 local_from = from_inv.xform(from - motion * 0.1);
-		Vector3 local_to = from_inv.xform(to);
-
-		Vector3 rpos, rnorm;
-		int fi = -1;
-		if (p_B->get_shape(p_shape_B)->intersect_segment(local_from, local_to, rpos, rnorm, fi, true)) {
-			float hit_length = local_from.distance_to(rpos);
-			if (hit_length < segment_hit_length) {
-				segment_support_idx = i;
-				segment_hit_length = hit_length;
-				segment_hit_local = rpos;
-			}
-		}
+	if (shape_A_ptr->is_concave() || shape_A_ptr->get_type() == PhysicsServer3D::SHAPE_SEPARATION_RAY || shape_B_ptr->get_type() == PhysicsServer3D::SHAPE_SEPARATION_RAY) {
+		return false;
 	}
 
-	if (segment_support_idx == -1) {
-		// There was no hit. Since the segment is the length of per-frame motion, this means the bodies will not
-		// actually collide yet on next frame. We'll probably check again next frame once they're closer.
+	// A is moving fast enough that tunneling might occur. See if it's really about to collide.
+	real_t margin = (max - min) * 0.01;
+	real_t toi = 1.0;
+	if (!GodotCollisionSolver3D::solve_time_of_impact(shape_A_ptr, p_xform_A, motion, shape_B_ptr, p_xform_B, margin, toi)) {
+		// No hit during this frame's motion. We'll check again next frame once they're closer.
 		return false;
 	}
 
-	Vector3 hitpos = predicted_xform_B.xform(segment_hit_local);
+	// Adding 1% of body length to the distance until impact should cause body A
+	// to arrive just within B's collider next frame.
+	real_t newlen = toi * mlen + margin;
+	if (newlen >= mlen) {
+		return false;
+	}
 
-	real_t newlen = hitpos.distance_to(supports_A[segment_support_idx]);
-	// Adding 1% of body length to the distance between collision and support point
-	// should cause body A's support point to arrive just within B's collider next frame.
-	newlen += (max - min) * 0.01;
-	// FIXME: This doesn't always work well when colliding with a triangle face of a trimesh shape.
+	// Speed of A along the sweep that closes the distance to B by newlen this step.
+	// B's share of the approach is left to B's own CCD, so this never goes below zero.
+	const Vector3 lv = p_A->get_linear_velocity();
+	real_t speed = lv.dot(mnormal);
+	real_t new_speed = MAX(p_B->get_linear_velocity().dot(mnormal) + newlen / p_step, (real_t)0.0);
+	if (new_speed >= speed) {
+		return false;
+	}
 
-	p_A->set_linear_velocity((mnormal * newlen) / p_step);
+	p_A->set_linear_velocity(lv + mnormal * (new_speed - speed));
 
 	return true;
 }
@@ -595,6 +568,40 @@ void GodotBodyPair3D::solve(real_t p_step) {
 	}
 }
 
+GodotBodyPair3D::SnapshotKey GodotBodyPair3D::get_snapshot_key() const {
+	SnapshotKey key;
+	key.body_A = A->get_self();
+	key.body_B = B->get_self();
+	key.shape_A = shape_A;
+	key.shape_B = shape_B;
+	return key;
+}
+
+void GodotBodyPair3D::save_snapshot(Snapshot &r_snapshot) const {
+	// Snapshots are compared and copied as raw bytes, so padding and unused fields must be zeroed.
+	memset((void *)&r_snapshot, 0, sizeof(Snapshot));
+	r_snapshot.key = get_snapshot_key();
+	r_snapshot.sep_axis = sep_axis;
+	r_snapshot.contact_count = contact_count;
+	for (int i = 0; i < contact_count; i++) {
+		r_snapshot.contacts[i] = contacts[i];
+	}
+}
+
+void GodotBodyPair3D::restore_snapshot(const Snapshot &p_snapshot) {
+	sep_axis = p_snapshot.sep_axis;
+	contact_count = CLAMP(p_snapshot.contact_count, 0, (int)MAX_CONTACTS);
+	for (int i = 0; i < contact_count; i++) {
+		contacts[i] = p_snapshot.contacts[i];
+	}
+}
+
+void GodotBodyPair3D::clear_snapshot() {
+	// Same as a newly created pair.
+	sep_axis = Vector3();
+	contact_count = 0;
+}
+
 GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B) :
 		GodotBodyContact3D(_arr, 2) {
 	A = p_A;
@@ -611,6 +618,229 @@ GodotBodyPair3D::~GodotBodyPair3D() {
 	B->remove_constraint(this);
 }
 
+void GodotBodyPairPack3D::pack(const LocalVector<GodotBodyPair3D *> &p_pairs) {
+	groups.clear();
+
+	uint32_t lane = LANE_COUNT;
+	for (GodotBodyPair3D *pair : p_pairs) {
+		if (!pair->collided) {
+			continue;
+		}
+
+		if (lane == LANE_COUNT) {
+			// Unused lanes stay zeroed, and inactive.
+			groups.push_back(Group());
+			lane = 0;
+		}
+		Group &group = groups[groups.size() - 1];
+
+		group.pairs[lane] = pair;
+
+		Basis zero_basis;
+		zero_basis.set_zero();
+
+		group.inv_mass_A[lane] = pair->collide_A ? pair->A->get_inv_mass() : 0.0;
+		group.inv_mass_B[lane] = pair->collide_B ? pair->B->get_inv_mass() : 0.0;
+		group.inv_inertia_tensor_A.set(lane, pair->collide_A ? pair->A->get_inv_inertia_tensor() : zero_basis);
+		group.inv_inertia_tensor_B.set(lane, pair->collide_B ? pair->B->get_inv_inertia_tensor() : zero_basis);
+		group.friction[lane] = combine_friction(pair->A, pair->B);
+
+		for (int i = 0; i < pair->contact_count; i++) {
+			const GodotBodyPair3D::Contact &c = pair->contacts[i];
+			ContactLanes &contact = group.contacts[i];
+			contact.rA.set(lane, c.rA);
+			contact.rB.set(lane, c.rB);
+			contact.normal.set(lane, c.normal);
+			contact.acc_impulse.set(lane, c.acc_impulse);
+			contact.acc_tangent_impulse.set(lane, c.acc_tangent_impulse);
+			contact.acc_normal_impulse[lane] = c.acc_normal_impulse;
+			contact.acc_bias_impulse[lane] = c.acc_bias_impulse;
+			contact.acc_bias_impulse_center_of_mass[lane] = c.acc_bias_impulse_center_of_mass;
+			contact.mass_normal[lane] = c.mass_normal;
+			contact.bias[lane] = c.bias;
+			contact.bounce[lane] = c.bounce;
+			contact.active[lane] = c.active;
+		}
+
+		lane++;
+	}
+}
+
+void GodotBodyPairPack3D::unpack() {
+	for (const Group &group : groups) {
+		for (int lane = 0; lane < LANE_COUNT; lane++) {
+			GodotBodyPair3D *pair = group.pairs[lane];
+			if (!pair) {
+				break;
+			}
+
+			for (int i = 0; i < pair->contact_count; i++) {
+				GodotBodyPair3D::Contact &c = pair->contacts[i];
+				const ContactLanes &contact = group.contacts[i];
+				c.acc_impulse = contact.acc_impulse.get(lane);
+				c.acc_tangent_impulse = contact.acc_tangent_impulse.get(lane);
+				c.acc_normal_impulse = contact.acc_normal_impulse[lane];
+				c.acc_bias_impulse = contact.acc_bias_impulse[lane];
+				c.acc_bias_impulse_center_of_mass = contact.acc_bias_impulse_center_of_mass[lane];
+				c.active = contact.active[lane];
+			}
+		}
+	}
+	groups.clear();
+}
+
+static _FORCE_INLINE_ Vector3 _limit_length(const Vector3 &p_vector, real_t p_max_length) {
+	real_t length = p_vector.length();
+	return p_vector * (length > p_max_length ? p_max_length / length : (real_t)1.0);
+}
+
+// Lane by lane equivalent of GodotBodyPair3D::solve() for one contact of each pair.
+// Impulses are masked by zeroing them instead of branching, so that the loop stays vectorizable.
+void GodotBodyPairPack3D::_solve_contacts(Group &p_group, ContactLanes &p_contacts, real_t p_max_bias_av) {
+	for (int lane = 0; lane < LANE_COUNT; lane++) {
+		const bool was_active = p_contacts.active[lane];
+
+		const Vector3 rA = p_contacts.rA.get(lane);
+		const Vector3 rB = p_contacts.rB.get(lane);
+		const Vector3 normal = p_contacts.normal.get(lane);
+		const real_t bias = p_contacts.bias[lane];
+		const real_t inv_mass_A = p_group.inv_mass_A[lane];
+		const real_t inv_mass_B = p_group.inv_mass_B[lane];
+
+		Vector3 lv_A = p_group.linear_velocity_A.get(lane);
+		Vector3 av_A = p_group.angular_velocity_A.get(lane);
+		Vector3 blv_A = p_group.biased_linear_velocity_A.get(lane);
+		Vector3 bav_A = p_group.biased_angular_velocity_A.get(lane);
+		Vector3 lv_B = p_group.linear_velocity_B.get(lane);
+		Vector3 av_B = p_group.angular_velocity_B.get(lane);
+		Vector3 blv_B = p_group.biased_linear_velocity_B.get(lane);
+		Vector3 bav_B = p_group.biased_angular_velocity_B.get(lane);
+
+		// Bias impulse.
+
+		real_t vbn = (blv_B + bav_B.cross(rB) - blv_A - bav_A.cross(rA)).dot(normal);
+		const bool apply_bias = was_active && Math::abs(-vbn + bias) > MIN_VELOCITY;
+
+		const real_t jbn_old = p_contacts.acc_bias_impulse[lane];
+		const real_t jbn_acc = apply_bias ? MAX(jbn_old + (-vbn + bias) * p_contacts.mass_normal[lane], (real_t)0.0) : jbn_old;
+		p_contacts.acc_bias_impulse[lane] = jbn_acc;
+
+		const Vector3 jb = normal * (jbn_acc - jbn_old);
+		blv_A -= jb * inv_mass_A;
+		bav_A += _limit_length(p_group.inv_inertia_tensor_A.xform(lane, rA.cross(-jb)), p_max_bias_av);
+		blv_B += jb * inv_mass_B;
+		bav_B += _limit_length(p_group.inv_inertia_tensor_B.xform(lane, rB.cross(jb)), p_max_bias_av);
+
+		vbn = (blv_B + bav_B.cross(rB) - blv_A - bav_A.cross(rA)).dot(normal);
+		const bool apply_bias_com = apply_bias && Math::abs(-vbn + bias) > MIN_VELOCITY;
+
+		const real_t jbn_com_old = p_contacts.acc_bias_impulse_center_of_mass[lane];
+		const real_t jbn_com_acc = apply_bias_com ? MAX(jbn_com_old + (-vbn + bias) / (inv_mass_A + inv_mass_B), (real_t)0.0) : jbn_com_old;
+		p_contacts.acc_bias_impulse_center_of_mass[lane] = jbn_com_acc;
+
+		const Vector3 jb_com = normal * (jbn_com_acc - jbn_com_old);
+		blv_A -= jb_com * inv_mass_A;
+		blv_B += jb_com * inv_mass_B;
+
+		// Normal impulse.
+
+		const real_t vn = (lv_B + av_B.cross(rB) - lv_A - av_A.cross(rA)).dot(normal);
+		const bool apply_normal = was_active && Math::abs(vn) > MIN_VELOCITY;
+
+		const real_t jn_old = p_contacts.acc_normal_impulse[lane];
+		const real_t jn_acc = apply_normal ? MAX(jn_old - (p_contacts.bounce[lane] + vn) * p_contacts.mass_normal[lane], (real_t)0.0) : jn_old;
+		p_contacts.acc_normal_impulse[lane] = jn_acc;
+
+		const Vector3 j = normal * (jn_acc - jn_old);
+		lv_A -= j * inv_mass_A;
+		av_A += p_group.inv_inertia_tensor_A.xform(lane, rA.cross(-j));
+		lv_B += j * inv_mass_B;
+		av_B += p_group.inv_inertia_tensor_B.xform(lane, rB.cross(j));
+
+		// Friction impulse.
+
+		const Vector3 dtv = lv_B + av_B.cross(rB) - lv_A - av_A.cross(rA);
+		Vector3 tv = dtv - normal * normal.dot(dtv);
+		const real_t tvl = tv.length();
+		const bool apply_friction = was_active && tvl > MIN_VELOCITY;
+		tv /= apply_friction ? tvl : (real_t)1.0;
+
+		const Vector3 temp_A = p_group.inv_inertia_tensor_A.xform(lane, rA.cross(tv));
+		const Vector3 temp_B = p_group.inv_inertia_tensor_B.xform(lane, rB.cross(tv));
+		const real_t t = -tvl / (inv_mass_A + inv_mass_B + tv.dot(temp_A.cross(rA) + temp_B.cross(rB)));
+
+		const Vector3 jt_old = p_contacts.acc_tangent_impulse.get(lane);
+		Vector3 jt_acc = jt_old + tv * t;
+		const real_t fi_len = jt_acc.length();
+		const real_t jt_max = jn_acc * p_group.friction[lane];
+		jt_acc *= (fi_len > CMP_EPSILON && fi_len > jt_max) ? jt_max / fi_len : (real_t)1.0;
+		jt_acc = apply_friction ? jt_acc : jt_old;
+		p_contacts.acc_tangent_impulse.set(lane, jt_acc);
+
+		const Vector3 jt = jt_acc - jt_old;
+		lv_A -= jt * inv_mass_A;
+		av_A += p_group.inv_inertia_tensor_A.xform(lane, rA.cross(-jt));
+		lv_B += jt * inv_mass_B;
+		av_B += p_group.inv_inertia_tensor_B.xform(lane, rB.cross(jt));
+
+		p_contacts.acc_impulse.set(lane, p_contacts.acc_impulse.get(lane) - j - jt);
+		p_contacts.active[lane] = apply_bias || apply_normal || apply_friction;
+
+		p_group.linear_velocity_A.set(lane, lv_A);
+		p_group.angular_velocity_A.set(lane, av_A);
+		p_group.biased_linear_velocity_A.set(lane, blv_A);
+		p_group.biased_angular_velocity_A.set(lane, bav_A);
+		p_group.linear_velocity_B.set(lane, lv_B);
+		p_group.angular_velocity_B.set(lane, av_B);
+		p_group.biased_linear_velocity_B.set(lane, blv_B);
+		p_group.biased_angular_velocity_B.set(lane, bav_B);
+	}
+}
+
+void GodotBodyPairPack3D::solve_group(uint32_t p_group_index, real_t p_step) {
+	Group &group = groups[p_group_index];
+
+	for (int lane = 0; lane < LANE_COUNT; lane++) {
+		const GodotBodyPair3D *pair = group.pairs[lane];
+		if (!pair) {
+			break;
+		}
+		group.linear_velocity_A.set(lane, pair->A->get_linear_velocity());
+		group.angular_velocity_A.set(lane, pair->A->get_angular_velocity());
+		group.biased_linear_velocity_A.set(lane, pair->A->get_biased_linear_velocity());
+		group.biased_angular_velocity_A.set(lane, pair->A->get_biased_angular_velocity());
+		group.linear_velocity_B.set(lane, pair->B->get_linear_velocity());
+		group.angular_velocity_B.set(lane, pair->B->get_angular_velocity());
+		group.biased_linear_velocity_B.set(lane, pair->B->get_biased_linear_velocity());
+		group.biased_angular_velocity_B.set(lane, pair->B->get_biased_angular_velocity());
+	}
+
+	const real_t max_bias_av = MAX_BIAS_ROTATION / p_step;
+	for (int i = 0; i < MAX_CONTACTS; i++) {
+		_solve_contacts(group, group.contacts[i], max_bias_av);
+	}
+
+	// Bodies that don't respond to the collision may be shared with other packs, leave them alone.
+	for (int lane = 0; lane < LANE_COUNT; lane++) {
+		GodotBodyPair3D *pair = group.pairs[lane];
+		if (!pair) {
+			break;
+		}
+		if (pair->collide_A) {
+			pair->A->set_linear_velocity(group.linear_velocity_A.get(lane));
+			pair->A->set_angular_velocity(group.angular_velocity_A.get(lane));
+			pair->A->set_biased_linear_velocity(group.biased_linear_velocity_A.get(lane));
+			pair->A->set_biased_angular_velocity(group.biased_angular_velocity_A.get(lane));
+		}
+		if (pair->collide_B) {
+			pair->B->set_linear_velocity(group.linear_velocity_B.get(lane));
+			pair->B->set_angular_velocity(group.angular_velocity_B.get(lane));
+			pair->B->set_biased_linear_velocity(group.biased_linear_velocity_B.get(lane));
+			pair->B->set_biased_angular_velocity(group.biased_angular_velocity_B.get(lane));
+		}
+	}
+}
+
 void GodotBodySoftBodyPair3D::_contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
 	GodotBodySoftBodyPair3D *pair = static_cast<GodotBodySoftBodyPair3D *>(p_userdata);
 	pair->contact_added_callback(p_point_A, p_index_A, p_point_B, p_index_B, normal);
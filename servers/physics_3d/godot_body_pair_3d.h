@@ -35,6 +35,7 @@
 #include "godot_constraint_3d.h"
 #include "godot_soft_body_3d.h"
 
+#include "core/templates/hashfuncs.h"
 #include "core/templates/local_vector.h"
 
 class GodotBodyContact3D : public GodotConstraint3D {
@@ -71,6 +72,8 @@ protected:
 };
 
 class GodotBodyPair3D : public GodotBodyContact3D {
+	friend class GodotBodyPairPack3D;
+
 	enum {
 		MAX_CONTACTS = 4
 	};
@@ -109,10 +112,128 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual GodotBodyPair3D *get_body_pair() override { return this; }
+
+	struct SnapshotKey {
+		RID body_A;
+		RID body_B;
+		int shape_A = 0;
+		int shape_B = 0;
+
+		static uint32_t hash(const SnapshotKey &p_key) {
+			uint32_t h = hash_murmur3_one_64(p_key.body_A.get_id());
+			h = hash_murmur3_one_64(p_key.body_B.get_id(), h);
+			h = hash_murmur3_one_32(p_key.shape_A, h);
+			h = hash_murmur3_one_32(p_key.shape_B, h);
+			return hash_fmix32(h);
+		}
+
+		bool operator==(const SnapshotKey &p_key) const {
+			return body_A == p_key.body_A && body_B == p_key.body_B && shape_A == p_key.shape_A && shape_B == p_key.shape_B;
+		}
+	};
+
+	// Contact cache saved and restored by space snapshots, so that the solver keeps
+	// its warm start data after a rollback.
+	struct Snapshot {
+		SnapshotKey key;
+		Vector3 sep_axis;
+		int contact_count = 0;
+		Contact contacts[MAX_CONTACTS];
+	};
+
+	SnapshotKey get_snapshot_key() const;
+	void save_snapshot(Snapshot &r_snapshot) const;
+	void restore_snapshot(const Snapshot &p_snapshot);
+	void clear_snapshot();
+
 	GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B);
 	~GodotBodyPair3D();
 };
 
+// Solves the contacts of many body pairs side by side, LANE_COUNT pairs at a time.
+// Lane data is stored as structure of arrays, so that the per-lane loops can be
+// vectorized by the compiler. Gives the same result as calling solve() on each pair,
+// as long as the pairs of a pack don't share any dynamic body.
+class GodotBodyPairPack3D {
+	enum {
+		LANE_COUNT = 4,
+		MAX_CONTACTS = GodotBodyPair3D::MAX_CONTACTS,
+	};
+
+	struct Vector3Lanes {
+		real_t x[LANE_COUNT];
+		real_t y[LANE_COUNT];
+		real_t z[LANE_COUNT];
+
+		_FORCE_INLINE_ Vector3 get(int p_lane) const { return Vector3(x[p_lane], y[p_lane], z[p_lane]); }
+		_FORCE_INLINE_ void set(int p_lane, const Vector3 &p_value) {
+			x[p_lane] = p_value.x;
+			y[p_lane] = p_value.y;
+			z[p_lane] = p_value.z;
+		}
+	};
+
+	struct BasisLanes {
+		Vector3Lanes rows[3];
+
+		_FORCE_INLINE_ Vector3 xform(int p_lane, const Vector3 &p_vector) const {
+			return Vector3(rows[0].get(p_lane).dot(p_vector), rows[1].get(p_lane).dot(p_vector), rows[2].get(p_lane).dot(p_vector));
+		}
+		_FORCE_INLINE_ void set(int p_lane, const Basis &p_basis) {
+			for (int i = 0; i < 3; i++) {
+				rows[i].set(p_lane, p_basis.rows[i]);
+			}
+		}
+	};
+
+	struct ContactLanes {
+		Vector3Lanes rA, rB;
+		Vector3Lanes normal;
+		Vector3Lanes acc_impulse;
+		Vector3Lanes acc_tangent_impulse;
+		real_t acc_normal_impulse[LANE_COUNT];
+		real_t acc_bias_impulse[LANE_COUNT];
+		real_t acc_bias_impulse_center_of_mass[LANE_COUNT];
+		real_t mass_normal[LANE_COUNT];
+		real_t bias[LANE_COUNT];
+		real_t bounce[LANE_COUNT];
+		bool active[LANE_COUNT];
+	};
+
+	struct Group {
+		GodotBodyPair3D *pairs[LANE_COUNT];
+
+		// Zero for bodies that don't respond to the collision.
+		real_t inv_mass_A[LANE_COUNT];
+		real_t inv_mass_B[LANE_COUNT];
+		BasisLanes inv_inertia_tensor_A;
+		BasisLanes inv_inertia_tensor_B;
+		real_t friction[LANE_COUNT];
+
+		Vector3Lanes linear_velocity_A, angular_velocity_A;
+		Vector3Lanes biased_linear_velocity_A, biased_angular_velocity_A;
+		Vector3Lanes linear_velocity_B, angular_velocity_B;
+		Vector3Lanes biased_linear_velocity_B, biased_angular_velocity_B;
+
+		ContactLanes contacts[MAX_CONTACTS];
+	};
+
+	LocalVector<Group> groups;
+
+	static void _solve_contacts(Group &p_group, ContactLanes &p_contacts, real_t p_max_bias_av);
+
+public:
+	// Packs the contacts of the given pairs, after they have been pre-solved.
+	void pack(const LocalVector<GodotBodyPair3D *> &p_pairs);
+	// Writes the accumulated impulses back to the pairs, for reporting and warm starting.
+	void unpack();
+
+	_FORCE_INLINE_ uint32_t get_group_count() const { return groups.size(); }
+	// Runs one solver iteration on a group, reading and writing the body velocities.
+	void solve_group(uint32_t p_group_index, real_t p_step);
+};
+
 class GodotBodySoftBodyPair3D : public GodotBodyContact3D {
 	GodotBody3D *body = nullptr;
 	GodotSoftBody3D *soft_body = nullptr;
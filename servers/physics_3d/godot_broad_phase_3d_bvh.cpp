@@ -32,6 +32,11 @@
 
 #include "godot_collision_object_3d.h"
 
+#include "core/object/worker_thread_pool.h"
+
+// Below this many moved objects, pair finding isn't worth dispatching to worker threads.
+#define PARALLEL_PAIRING_MIN_ITEMS 256
+
 GodotBroadPhase3DBVH::ID GodotBroadPhase3DBVH::create(GodotCollisionObject3D *p_object, int p_subindex, const AABB &p_aabb, bool p_static) {
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
 	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
@@ -82,6 +87,10 @@ int GodotBroadPhase3DBVH::cull_segment(const Vector3 &p_from, const Vector3 &p_t
 	return bvh.cull_segment(p_from, p_to, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
 }
 
+int GodotBroadPhase3DBVH::cull_segment_concurrent(const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices) const {
+	return bvh.cull_segment_concurrent(p_from, p_to, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
+}
+
 int GodotBroadPhase3DBVH::cull_aabb(const AABB &p_aabb, GodotCollisionObject3D **p_results, int p_max_results, int *p_result_indices) {
 	return bvh.cull_aabb(p_aabb, p_results, p_max_results, nullptr, 0xFFFFFFFF, p_result_indices);
 }
@@ -104,6 +113,11 @@ void GodotBroadPhase3DBVH::_unpair_callback(void *self, uint32_t p_A, GodotColli
 	bpo->unpair_callback(p_object_A, subindex_A, p_object_B, subindex_B, pairdata, bpo->unpair_userdata);
 }
 
+void GodotBroadPhase3DBVH::_parallel_pairing_callback(void *self, void (*p_func)(void *, uint32_t), void *p_func_userdata, uint32_t p_count) {
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(p_func, p_func_userdata, p_count, -1, true, SNAME("Physics3DBroadphasePairing"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 void GodotBroadPhase3DBVH::set_pair_callback(PairCallback p_pair_callback, void *p_userdata) {
 	pair_callback = p_pair_callback;
 	pair_userdata = p_userdata;
@@ -125,4 +139,5 @@ GodotBroadPhase3D *GodotBroadPhase3DBVH::_create() {
 GodotBroadPhase3DBVH::GodotBroadPhase3DBVH() {
 	bvh.set_pair_callback(_pair_callback, this);
 	bvh.set_unpair_callback(_unpair_callback, this);
+	bvh.set_parallel_pairing_callback(_parallel_pairing_callback, this, PARALLEL_PAIRING_MIN_ITEMS);
 }
@@ -85,6 +85,7 @@ void GodotCollisionObject3D::set_shape_disabled(int p_idx, bool p_disabled) {
 
 	if (p_disabled && shape.bpid != 0) {
 		space->get_broadphase()->remove(shape.bpid);
+		space->broadphase_changed(this, false);
 		shape.bpid = 0;
 		if (!pending_shape_update_list.in_list()) {
 			GodotPhysicsServer3D::godot_singleton->pending_shape_update_list.add(&pending_shape_update_list);
@@ -115,6 +116,7 @@ void GodotCollisionObject3D::remove_shape(int p_index) {
 		}
 		//should never get here with a null owner
 		space->get_broadphase()->remove(shapes[i].bpid);
+		space->broadphase_changed(this, false);
 		shapes.write[i].bpid = 0;
 	}
 	shapes[p_index].shape->remove_owner(this);
@@ -140,6 +142,7 @@ void GodotCollisionObject3D::_set_static(bool p_static) {
 			space->get_broadphase()->set_static(s.bpid, _static);
 		}
 	}
+	space->broadphase_changed(this, false);
 }
 
 void GodotCollisionObject3D::_unregister_shapes() {
@@ -147,6 +150,7 @@ void GodotCollisionObject3D::_unregister_shapes() {
 		Shape &s = shapes.write[i];
 		if (s.bpid > 0) {
 			space->get_broadphase()->remove(s.bpid);
+			space->broadphase_changed(this, false);
 			s.bpid = 0;
 		}
 	}
@@ -176,9 +180,11 @@ void GodotCollisionObject3D::_update_shapes() {
 		if (s.bpid == 0) {
 			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
 			space->get_broadphase()->set_static(s.bpid, _static);
+			space->broadphase_changed(this, false);
 		}
 
 		space->get_broadphase()->move(s.bpid, shape_aabb);
+		space->broadphase_changed(this, true);
 	}
 }
 
@@ -203,9 +209,11 @@ void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion)
 		if (s.bpid == 0) {
 			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
 			space->get_broadphase()->set_static(s.bpid, _static);
+			space->broadphase_changed(this, false);
 		}
 
 		space->get_broadphase()->move(s.bpid, shape_aabb);
+		space->broadphase_changed(this, true);
 	}
 }
 
@@ -217,6 +225,7 @@ void GodotCollisionObject3D::_set_space(GodotSpace3D *p_space) {
 			Shape &s = shapes.write[i];
 			if (s.bpid) {
 				space->get_broadphase()->remove(s.bpid);
+				space->broadphase_changed(this, false);
 				s.bpid = 0;
 			}
 		}
@@ -587,3 +587,94 @@ bool GodotCollisionSolver3D::solve_distance(const GodotShape3D *p_shape_A, const
 		return gjk_epa_calculate_distance(p_shape_A, p_transform_A, p_shape_B, p_transform_B, r_point_A, r_point_B); //should pass sepaxis..
 	}
 }
+
+#define TIME_OF_IMPACT_MAX_ITERATIONS 32
+
+// Conservative advancement: the distance along the current separating direction can't shrink faster than
+// the motion projected on it, so advancing by distance / closing speed never steps past the first contact.
+bool GodotCollisionSolver3D::solve_time_of_impact_convex(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const Vector3 &p_motion_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, real_t p_tolerance, real_t &r_toi) {
+	real_t t = 0.0;
+
+	for (int i = 0; i < TIME_OF_IMPACT_MAX_ITERATIONS; i++) {
+		Vector3 point_A, point_B;
+		if (!solve_distance(p_shape_A, p_transform_A.translated(p_motion_A * t), p_shape_B, p_transform_B, point_A, point_B, AABB())) {
+			// Already overlapping.
+			r_toi = t;
+			return true;
+		}
+
+		Vector3 separation = point_B - point_A;
+		real_t distance = separation.length();
+		if (distance <= p_tolerance) {
+			r_toi = t;
+			return true;
+		}
+
+		real_t closing_distance = p_motion_A.dot(separation / distance);
+		if (closing_distance <= CMP_EPSILON) {
+			return false; // Moving apart.
+		}
+
+		t += (distance - p_tolerance * 0.5) / closing_distance;
+		if (t > 1.0) {
+			return false;
+		}
+	}
+
+	// Didn't converge, but t is still a safe (early) estimate.
+	r_toi = t;
+	return true;
+}
+
+struct _ConcaveTimeOfImpactInfo {
+	const GodotShape3D *shape_A = nullptr;
+	const Transform3D *transform_A = nullptr;
+	Vector3 motion_A;
+	const Transform3D *transform_B = nullptr;
+	real_t tolerance = 0.0;
+	bool hit = false;
+	real_t toi = 1.0;
+};
+
+bool GodotCollisionSolver3D::concave_time_of_impact_callback(void *p_userdata, GodotShape3D *p_convex) {
+	_ConcaveTimeOfImpactInfo &tinfo = *(static_cast<_ConcaveTimeOfImpactInfo *>(p_userdata));
+
+	real_t toi = 1.0;
+	if (solve_time_of_impact_convex(tinfo.shape_A, *tinfo.transform_A, tinfo.motion_A, p_convex, *tinfo.transform_B, tinfo.tolerance, toi) && toi < tinfo.toi) {
+		tinfo.toi = toi;
+		tinfo.hit = true;
+	}
+
+	// No need to look further once a face is hit right away.
+	return tinfo.hit && tinfo.toi == 0.0;
+}
+
+bool GodotCollisionSolver3D::solve_time_of_impact(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const Vector3 &p_motion_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, real_t p_tolerance, real_t &r_toi) {
+	ERR_FAIL_COND_V(p_shape_A->is_concave(), false);
+
+	if (!p_shape_B->is_concave()) {
+		return solve_time_of_impact_convex(p_shape_A, p_transform_A, p_motion_A, p_shape_B, p_transform_B, p_tolerance, r_toi);
+	}
+
+	const GodotConcaveShape3D *concave_B = static_cast<const GodotConcaveShape3D *>(p_shape_B);
+
+	// Only faces touching the swept volume of A can be hit.
+	AABB swept_aabb = p_transform_A.xform(p_shape_A->get_aabb());
+	swept_aabb.merge_with(AABB(swept_aabb.position + p_motion_A, swept_aabb.size));
+	swept_aabb.grow_by(p_tolerance);
+	AABB local_aabb = p_transform_B.affine_inverse().xform(swept_aabb);
+
+	_ConcaveTimeOfImpactInfo tinfo;
+	tinfo.shape_A = p_shape_A;
+	tinfo.transform_A = &p_transform_A;
+	tinfo.motion_A = p_motion_A;
+	tinfo.transform_B = &p_transform_B;
+	tinfo.tolerance = p_tolerance;
+
+	concave_B->cull(local_aabb, concave_time_of_impact_callback, &tinfo, false);
+
+	if (tinfo.hit) {
+		r_toi = tinfo.toi;
+	}
+	return tinfo.hit;
+}
@@ -48,10 +48,15 @@ private:
 	static bool solve_concave(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, bool p_swap_result, real_t p_margin_A = 0, real_t p_margin_B = 0);
 	static bool concave_distance_callback(void *p_userdata, GodotShape3D *p_convex);
 	static bool solve_distance_world_boundary(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, Vector3 &r_point_A, Vector3 &r_point_B);
+	static bool concave_time_of_impact_callback(void *p_userdata, GodotShape3D *p_convex);
+	static bool solve_time_of_impact_convex(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const Vector3 &p_motion_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, real_t p_tolerance, real_t &r_toi);
 
 public:
 	static bool solve_static(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, Vector3 *r_sep_axis = nullptr, real_t p_margin_A = 0, real_t p_margin_B = 0);
 	static bool solve_distance(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, Vector3 &r_point_A, Vector3 &r_point_B, const AABB &p_concave_hint, Vector3 *r_sep_axis = nullptr);
+	// Sweeps convex shape A by p_motion_A against shape B, which may be concave. Returns true if they come
+	// within p_tolerance of each other during the motion, with r_toi the fraction of the motion until then.
+	static bool solve_time_of_impact(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const Vector3 &p_motion_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, real_t p_tolerance, real_t &r_toi);
 };
 
 #endif // GODOT_COLLISION_SOLVER_3D_H
@@ -32,6 +32,7 @@
 #define GODOT_CONSTRAINT_3D_H
 
 class GodotBody3D;
+class GodotBodyPair3D;
 class GodotSoftBody3D;
 
 class GodotConstraint3D {
@@ -62,6 +63,9 @@ public:
 	_FORCE_INLINE_ GodotBody3D **get_body_ptr() const { return _body_ptr; }
 	_FORCE_INLINE_ int get_body_count() const { return _body_count; }
 
+	// Body pairs can also be solved in packs, see GodotBodyPairPack3D.
+	virtual GodotBodyPair3D *get_body_pair() { return nullptr; }
+
 	virtual GodotSoftBody3D *get_soft_body_ptr(int p_index) const { return nullptr; }
 	virtual int get_soft_body_count() const { return 0; }
 
@@ -214,6 +214,18 @@ int GodotPhysicsServer3D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+Vector<uint8_t> GodotPhysicsServer3D::space_save_state(RID p_space) const {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND_V(!space, Vector<uint8_t>());
+	return space->save_state();
+}
+
+bool GodotPhysicsServer3D::space_restore_state(RID p_space, const Vector<uint8_t> &p_state) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_COND_V(!space, false);
+	return space->restore_state(p_state);
+}
+
 RID GodotPhysicsServer3D::area_create() {
 	GodotArea3D *area = memnew(GodotArea3D);
 	RID rid = area_owner.make_rid(area);
@@ -1625,6 +1637,8 @@ void GodotPhysicsServer3D::set_active(bool p_active) {
 }
 
 void GodotPhysicsServer3D::init() {
+	// Either the main thread, or the physics thread when running on a separate thread.
+	server_thread = Thread::get_caller_id();
 	stepper = memnew(GodotStep3D);
 }
 
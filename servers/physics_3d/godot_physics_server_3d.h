@@ -36,6 +36,7 @@
 #include "godot_space_3d.h"
 #include "godot_step_3d.h"
 
+#include "core/os/thread.h"
 #include "core/templates/rid_owner.h"
 #include "servers/physics_server_3d.h"
 
@@ -52,6 +53,7 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	bool using_threads = false;
 	bool doing_sync = false;
 	bool flushing_queries = false;
+	Thread::ID server_thread = Thread::UNASSIGNED_ID; // Thread the server was initialized on, see init().
 
 	GodotStep3D *stepper = nullptr;
 	HashSet<const GodotSpace3D *> active_spaces;
@@ -117,6 +119,9 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual Vector<uint8_t> space_save_state(RID p_space) const override;
+	virtual bool space_restore_state(RID p_space, const Vector<uint8_t> &p_state) override;
+
 	/* AREA API */
 
 	virtual RID area_create() override;
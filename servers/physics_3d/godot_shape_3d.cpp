@@ -1429,33 +1429,41 @@ Vector3 GodotConcavePolygonShape3D::get_closest_point_to(const Vector3 &p_point)
 }
 
 bool GodotConcavePolygonShape3D::_cull(int p_idx, _CullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
+	// The tree is built by median splits, so it stays balanced and this depth is never reached in practice.
+	const int max_depth = 64;
+	int stack[max_depth];
+	int stack_size = 0;
 
-	if (!p_params->aabb.intersects(params_bvh->aabb)) {
-		return false;
-	}
+	stack[stack_size++] = p_idx;
 
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-		if (p_params->callback(p_params->userdata, face)) {
-			return true;
+	while (stack_size > 0) {
+		const BVH *params_bvh = &p_params->bvh[stack[--stack_size]];
+
+		if (!p_params->aabb.intersects(params_bvh->aabb)) {
+			continue;
 		}
-	} else {
-		if (params_bvh->left >= 0) {
-			if (_cull(params_bvh->left, p_params)) {
+
+		if (params_bvh->face_index >= 0) {
+			const Face *f = &p_params->faces[params_bvh->face_index];
+			GodotFaceShape3D *face = p_params->face;
+			face->normal = f->normal;
+			face->vertex[0] = p_params->vertices[f->indices[0]];
+			face->vertex[1] = p_params->vertices[f->indices[1]];
+			face->vertex[2] = p_params->vertices[f->indices[2]];
+			if (p_params->callback(p_params->userdata, face)) {
 				return true;
 			}
+			continue;
 		}
 
+		ERR_FAIL_COND_V(stack_size + 2 > max_depth, false);
+
+		// Push right first, so the left subtree is visited first like before.
 		if (params_bvh->right >= 0) {
-			if (_cull(params_bvh->right, p_params)) {
-				return true;
-			}
+			stack[stack_size++] = params_bvh->right;
+		}
+		if (params_bvh->left >= 0) {
+			stack[stack_size++] = params_bvh->left;
 		}
 	}
 
@@ -2051,27 +2059,69 @@ void GodotHeightMapShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callb
 	int start_z = MAX(0, aabb_min[2]);
 	int end_z = MIN(depth - 1, aabb_max[2]);
 
+	if (start_x >= end_x || start_z >= end_z) {
+		return;
+	}
+
+	// Cells and chunks entirely above or below the aabb can't produce any contact,
+	// so they are skipped before generating faces for them.
+	const real_t min_y = local_aabb.position.y;
+	const real_t max_y = local_aabb.position.y + local_aabb.size.y;
+
 	GodotFaceShape3D face;
 	face.backface_collision = !p_invert_backface_collision;
 	face.invert_backface_collision = p_invert_backface_collision;
 
-	for (int z = start_z; z < end_z; z++) {
-		for (int x = start_x; x < end_x; x++) {
-			// First triangle.
-			_get_point(x, z, face.vertex[0]);
-			_get_point(x + 1, z, face.vertex[1]);
-			_get_point(x, z + 1, face.vertex[2]);
-			face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
-			if (p_callback(p_userdata, &face)) {
-				return;
+	const bool use_bounds_grid = !bounds_grid.is_empty();
+
+	int start_chunk_x = start_x / BOUNDS_CHUNK_SIZE;
+	int end_chunk_x = (end_x - 1) / BOUNDS_CHUNK_SIZE;
+	int start_chunk_z = start_z / BOUNDS_CHUNK_SIZE;
+	int end_chunk_z = (end_z - 1) / BOUNDS_CHUNK_SIZE;
+
+	for (int cz = start_chunk_z; cz <= end_chunk_z; cz++) {
+		int chunk_start_z = MAX(start_z, cz * BOUNDS_CHUNK_SIZE);
+		int chunk_end_z = MIN(end_z, (cz + 1) * BOUNDS_CHUNK_SIZE);
+
+		for (int cx = start_chunk_x; cx <= end_chunk_x; cx++) {
+			if (use_bounds_grid) {
+				const Range &chunk = _get_bounds_chunk(cx, cz);
+				if (chunk.max < min_y || chunk.min > max_y) {
+					continue;
+				}
 			}
 
-			// Second triangle.
-			face.vertex[0] = face.vertex[1];
-			_get_point(x + 1, z + 1, face.vertex[1]);
-			face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
-			if (p_callback(p_userdata, &face)) {
-				return;
+			int chunk_start_x = MAX(start_x, cx * BOUNDS_CHUNK_SIZE);
+			int chunk_end_x = MIN(end_x, (cx + 1) * BOUNDS_CHUNK_SIZE);
+
+			for (int z = chunk_start_z; z < chunk_end_z; z++) {
+				for (int x = chunk_start_x; x < chunk_end_x; x++) {
+					real_t h00 = _get_height(x, z);
+					real_t h10 = _get_height(x + 1, z);
+					real_t h01 = _get_height(x, z + 1);
+					real_t h11 = _get_height(x + 1, z + 1);
+
+					if (MAX(MAX(h00, h10), MAX(h01, h11)) < min_y || MIN(MIN(h00, h10), MIN(h01, h11)) > max_y) {
+						continue;
+					}
+
+					// First triangle.
+					_get_point(x, z, face.vertex[0]);
+					_get_point(x + 1, z, face.vertex[1]);
+					_get_point(x, z + 1, face.vertex[2]);
+					face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
+					if (p_callback(p_userdata, &face)) {
+						return;
+					}
+
+					// Second triangle.
+					face.vertex[0] = face.vertex[1];
+					_get_point(x + 1, z + 1, face.vertex[1]);
+					face.normal = Plane(face.vertex[0], face.vertex[1], face.vertex[2]).normal;
+					if (p_callback(p_userdata, &face)) {
+						return;
+					}
+				}
 			}
 		}
 	}
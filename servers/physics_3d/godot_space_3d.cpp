@@ -34,9 +34,11 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
+#define INTERSECT_RAYS_PARALLEL_MIN_COUNT 64
 
 _FORCE_INLINE_ static bool _can_collide_with(GodotCollisionObject3D *p_object, uint32_t p_collision_mask, bool p_collide_with_bodies, bool p_collide_with_areas) {
 	if (!(p_object->get_collision_layer() & p_collision_mask)) {
@@ -108,14 +110,66 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
 	ERR_FAIL_COND_V(space->locked, false);
 
+	int amount = space->broadphase->cull_segment(p_parameters.from, p_parameters.to, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	return _intersect_ray_candidates(p_parameters, p_parameters.from, p_parameters.to, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_result);
+}
+
+void GodotPhysicsDirectSpaceState3D::_intersect_ray_batch(uint32_t p_index, RayBatch *p_batch) {
+	// Each thread culls into its own buffers, since the space's shared ones can't be used concurrently.
+	// They are kept on the heap and reused, a full query result is too large for the stack of a worker.
+	thread_local LocalVector<GodotCollisionObject3D *> objects;
+	thread_local LocalVector<int> subindices;
+	if (objects.size() < GodotSpace3D::INTERSECTION_QUERY_MAX) {
+		objects.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+		subindices.resize(GodotSpace3D::INTERSECTION_QUERY_MAX);
+	}
+
+	const Vector3 &from = p_batch->from[p_index];
+	const Vector3 &to = p_batch->to[p_index];
+
+	int amount = space->broadphase->cull_segment_concurrent(from, to, objects.ptr(), GodotSpace3D::INTERSECTION_QUERY_MAX, subindices.ptr());
+
+	p_batch->hits[p_index] = _intersect_ray_candidates(*p_batch->parameters, from, to, objects.ptr(), subindices.ptr(), amount, p_batch->results[p_index]);
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND(space->locked);
+
+	if (p_count <= 0) {
+		return;
+	}
+
+	RayBatch batch;
+	batch.parameters = &p_parameters;
+	batch.from = p_from;
+	batch.to = p_to;
+	batch.results = r_results;
+	batch.hits = r_hits;
+
+	// Waiting on the pool from one of its own threads could starve it, e.g. when called from a node
+	// processed in a sub-thread group, so only the main and physics threads split the work.
+	const Thread::ID caller = Thread::get_caller_id();
+	const bool can_wait_on_pool = caller == Thread::get_main_id() || caller == GodotPhysicsServer3D::godot_singleton->server_thread;
+
+	if (p_count < INTERSECT_RAYS_PARALLEL_MIN_COUNT || !can_wait_on_pool) {
+		for (int i = 0; i < p_count; i++) {
+			_intersect_ray_batch(i, &batch);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_ray_batch, &batch, p_count, -1, true, SNAME("Physics3DIntersectRays"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray_candidates(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D *const *p_objects, const int *p_subindices, int p_amount, RayResult &r_result) const {
 	Vector3 begin, end;
 	Vector3 normal;
-	begin = p_parameters.from;
-	end = p_parameters.to;
+	begin = p_from;
+	end = p_to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
 	bool collided = false;
@@ -125,22 +179,22 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	const GodotCollisionObject3D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(p_objects[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(p_objects[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_objects[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = p_objects[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_subindices[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -615,8 +669,8 @@ GodotPhysicsDirectSpaceState3D::GodotPhysicsDirectSpaceState3D() {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-int GodotSpace3D::_cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb) {
-	int amount = broadphase->cull_aabb(p_aabb, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+int GodotSpace3D::_filter_results_for_body(GodotBody3D *p_body, int p_amount) {
+	int amount = p_amount;
 
 	for (int i = 0; i < amount; i++) {
 		bool keep = true;
@@ -647,6 +701,61 @@ int GodotSpace3D::_cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb) {
 	return amount;
 }
 
+int GodotSpace3D::_cull_aabb_for_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, const AABB &p_aabb, bool &r_complete) {
+	int amount = 0;
+	if (motion_cull_body == p_body && motion_cull_aabb.encloses(p_aabb)) {
+		// Nothing but this body changed in the broadphase since the last cull, e.g. between the motions of one move_and_slide().
+		amount = motion_cull_objects.size();
+		memcpy(intersection_query_results, motion_cull_objects.ptr(), amount * sizeof(GodotCollisionObject3D *));
+		memcpy(intersection_query_subindex_results, motion_cull_subindices.ptr(), amount * sizeof(int));
+		r_complete = true;
+	} else {
+		amount = broadphase->cull_aabb(p_aabb, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+		// At the limit, objects may be missing from the results, so they aren't kept for later motions.
+		r_complete = amount < INTERSECTION_QUERY_MAX;
+		if (r_complete) {
+			motion_cull_body = p_body;
+			motion_cull_aabb = p_aabb;
+			motion_cull_objects.resize(amount);
+			motion_cull_subindices.resize(amount);
+			memcpy(motion_cull_objects.ptr(), intersection_query_results, amount * sizeof(GodotCollisionObject3D *));
+			memcpy(motion_cull_subindices.ptr(), intersection_query_subindex_results, amount * sizeof(int));
+		} else {
+			motion_cull_body = nullptr;
+		}
+	}
+
+	// Filtered on every call, collision layers and exceptions can change without touching the broadphase.
+	amount = _filter_results_for_body(p_body, amount);
+
+	for (int i = 0; i < amount; i++) {
+		const GodotCollisionObject3D *col_obj = intersection_query_results[i];
+		if (p_parameters.exclude_bodies.has(col_obj->get_self()) || p_parameters.exclude_objects.has(col_obj->get_instance_id())) {
+			if (i < amount - 1) {
+				SWAP(intersection_query_results[i], intersection_query_results[amount - 1]);
+				SWAP(intersection_query_subindex_results[i], intersection_query_subindex_results[amount - 1]);
+			}
+
+			amount--;
+			i--;
+		}
+	}
+
+	return amount;
+}
+
+int GodotSpace3D::_select_motion_candidates(const AABB &p_aabb, int p_amount, int *r_candidates) const {
+	int count = 0;
+
+	for (int i = 0; i < p_amount; i++) {
+		if (intersection_query_results[i]->get_shape_aabb(intersection_query_subindex_results[i]).intersects_inclusive(p_aabb)) {
+			r_candidates[count++] = i;
+		}
+	}
+
+	return count;
+}
+
 bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result) {
 	//give me back regular physics engine logic
 	//this is madness
@@ -698,6 +807,27 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 
 	Transform3D body_transform = p_parameters.from;
 
+	// The broadphase is queried once around the whole motion, and each step below only picks its candidates
+	// from that list. The region reaches as far as the motion in every direction, so that it also covers the
+	// shorter motions move_and_slide() makes next from where this one stops, which can then reuse the cull.
+	// It's queried again if recovery pushes the body out of the region, and for each step's own region if the
+	// cull reached the result limit.
+	AABB cull_aabb = body_aabb.grow(motion_length + margin);
+	bool cull_complete = true;
+	int cull_amount = _cull_aabb_for_motion(p_body, p_parameters, cull_aabb, cull_complete);
+	int candidates[INTERSECTION_QUERY_MAX];
+
+	auto select_candidates = [&](const AABB &p_aabb) -> int {
+		if (!cull_complete) {
+			cull_aabb = p_aabb;
+			cull_amount = _cull_aabb_for_motion(p_body, p_parameters, cull_aabb, cull_complete);
+		} else if (!cull_aabb.encloses(p_aabb)) {
+			cull_aabb = p_aabb.grow(motion_length + margin);
+			cull_amount = _cull_aabb_for_motion(p_body, p_parameters, cull_aabb, cull_complete);
+		}
+		return _select_motion_candidates(p_aabb, cull_amount, candidates);
+	};
+
 	bool recovered = false;
 
 	{
@@ -720,7 +850,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 
 			bool collided = false;
 
-			int amount = _cull_aabb_for_body(p_body, body_aabb);
+			int amount = select_candidates(body_aabb);
 
 			for (int j = 0; j < p_body->get_shape_count(); j++) {
 				if (p_body->is_shape_disabled(j)) {
@@ -731,15 +861,8 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 				GodotShape3D *body_shape = p_body->get_shape(j);
 
 				for (int i = 0; i < amount; i++) {
-					const GodotCollisionObject3D *col_obj = intersection_query_results[i];
-					if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
-						continue;
-					}
-					if (p_parameters.exclude_objects.has(col_obj->get_instance_id())) {
-						continue;
-					}
-
-					int shape_idx = intersection_query_subindex_results[i];
+					const GodotCollisionObject3D *col_obj = intersection_query_results[candidates[i]];
+					int shape_idx = intersection_query_subindex_results[candidates[i]];
 
 					if (GodotCollisionSolver3D::solve_static(body_shape, body_shape_xform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), cbkres, cbkptr, nullptr, margin)) {
 						collided = cbk.amount > 0;
@@ -804,7 +927,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 		motion_aabb.position += p_parameters.motion;
 		motion_aabb = motion_aabb.merge(body_aabb);
 
-		int amount = _cull_aabb_for_body(p_body, motion_aabb);
+		int amount = select_candidates(motion_aabb);
 
 		for (int j = 0; j < p_body->get_shape_count(); j++) {
 			if (p_body->is_shape_disabled(j)) {
@@ -835,15 +958,8 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 			real_t best_unsafe = 1;
 
 			for (int i = 0; i < amount; i++) {
-				const GodotCollisionObject3D *col_obj = intersection_query_results[i];
-				if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
-					continue;
-				}
-				if (p_parameters.exclude_objects.has(col_obj->get_instance_id())) {
-					continue;
-				}
-
-				int shape_idx = intersection_query_subindex_results[i];
+				const GodotCollisionObject3D *col_obj = intersection_query_results[candidates[i]];
+				int shape_idx = intersection_query_subindex_results[candidates[i]];
 
 				//test initial overlap, does it collide if going all the way?
 				Vector3 point_A, point_B;
@@ -944,7 +1060,7 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 		rcd.min_allowed_depth = MIN(motion_length, min_contact_depth);
 
 		body_aabb.position += p_parameters.motion * unsafe;
-		int amount = _cull_aabb_for_body(p_body, body_aabb);
+		int amount = select_candidates(body_aabb);
 
 		int from_shape = best_shape != -1 ? best_shape : 0;
 		int to_shape = best_shape != -1 ? best_shape + 1 : p_body->get_shape_count();
@@ -958,15 +1074,8 @@ bool GodotSpace3D::test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::
 			GodotShape3D *body_shape = p_body->get_shape(j);
 
 			for (int i = 0; i < amount; i++) {
-				const GodotCollisionObject3D *col_obj = intersection_query_results[i];
-				if (p_parameters.exclude_bodies.has(col_obj->get_self())) {
-					continue;
-				}
-				if (p_parameters.exclude_objects.has(col_obj->get_instance_id())) {
-					continue;
-				}
-
-				int shape_idx = intersection_query_subindex_results[i];
+				const GodotCollisionObject3D *col_obj = intersection_query_results[candidates[i]];
+				int shape_idx = intersection_query_subindex_results[candidates[i]];
 
 				rcd.object = col_obj;
 				rcd.shape = shape_idx;
@@ -1237,6 +1346,157 @@ real_t GodotSpace3D::get_param(PhysicsServer3D::SpaceParameter p_param) const {
 	return 0;
 }
 
+// Snapshots are raw copies of the body and contact structs, so they can only be
+// restored by the same build that saved them. The header is used to check that.
+struct _SpaceSnapshotHeader3D {
+	static const uint32_t MAGIC = 0x33535047; // "GPS3"
+
+	uint32_t magic = MAGIC;
+	uint32_t real_size = sizeof(real_t);
+	uint32_t body_size = sizeof(GodotBody3D::Snapshot);
+	uint32_t pair_size = sizeof(GodotBodyPair3D::Snapshot);
+	uint32_t body_count = 0;
+	uint32_t pair_count = 0;
+};
+
+Vector<uint8_t> GodotSpace3D::save_state() const {
+	ERR_FAIL_COND_V_MSG(locked, Vector<uint8_t>(), "Space state can't be saved while the space is being stepped.");
+
+	// Active bodies come first and in order, so that restoring puts the active list back as it was
+	// and the bodies are solved in the same order as during the original simulation.
+	LocalVector<const GodotBody3D *> bodies;
+	const SelfList<GodotBody3D> *active_body = active_list.first();
+	while (active_body) {
+		bodies.push_back(active_body->self());
+		active_body = active_body->next();
+	}
+
+	LocalVector<const GodotBodyPair3D *> pairs;
+	for (const GodotCollisionObject3D *object : objects) {
+		if (object->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+
+		const GodotBody3D *body = static_cast<const GodotBody3D *>(object);
+		if (!body->is_active()) {
+			bodies.push_back(body);
+		}
+
+		for (const KeyValue<GodotConstraint3D *, int> &E : body->get_constraint_map()) {
+			// Each pair is in the constraint map of both its bodies, only take it from A.
+			const GodotBodyPair3D *pair = E.key->get_body_pair();
+			if (pair && E.value == 0) {
+				pairs.push_back(pair);
+			}
+		}
+	}
+
+	_SpaceSnapshotHeader3D header;
+	header.body_count = bodies.size();
+	header.pair_count = pairs.size();
+
+	Vector<uint8_t> state;
+	state.resize(sizeof(header) + bodies.size() * sizeof(GodotBody3D::Snapshot) + pairs.size() * sizeof(GodotBodyPair3D::Snapshot));
+	uint8_t *w = state.ptrw();
+
+	memcpy(w, &header, sizeof(header));
+	w += sizeof(header);
+
+	for (const GodotBody3D *body : bodies) {
+		GodotBody3D::Snapshot snapshot;
+		body->save_snapshot(snapshot);
+		memcpy(w, &snapshot, sizeof(snapshot));
+		w += sizeof(snapshot);
+	}
+
+	for (const GodotBodyPair3D *pair : pairs) {
+		GodotBodyPair3D::Snapshot snapshot;
+		pair->save_snapshot(snapshot);
+		memcpy(w, &snapshot, sizeof(snapshot));
+		w += sizeof(snapshot);
+	}
+
+	return state;
+}
+
+bool GodotSpace3D::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_V_MSG(locked, false, "Space state can't be restored while the space is being stepped.");
+	ERR_FAIL_COND_V(p_state.size() < (int)sizeof(_SpaceSnapshotHeader3D), false);
+
+	const uint8_t *r = p_state.ptr();
+
+	_SpaceSnapshotHeader3D header;
+	const _SpaceSnapshotHeader3D expected_header;
+	memcpy(&header, r, sizeof(header));
+	r += sizeof(header);
+
+	ERR_FAIL_COND_V_MSG(header.magic != expected_header.magic || header.real_size != expected_header.real_size || header.body_size != expected_header.body_size || header.pair_size != expected_header.pair_size, false, "Space state was saved by an incompatible build.");
+	ERR_FAIL_COND_V(p_state.size() != (int)(sizeof(header) + header.body_count * sizeof(GodotBody3D::Snapshot) + header.pair_count * sizeof(GodotBodyPair3D::Snapshot)), false);
+
+	HashMap<RID, GodotBody3D *> bodies_by_rid;
+	for (GodotCollisionObject3D *object : objects) {
+		if (object->get_type() == GodotCollisionObject3D::TYPE_BODY) {
+			bodies_by_rid.insert(object->get_self(), static_cast<GodotBody3D *>(object));
+		}
+	}
+
+	// Bodies that have been removed since the state was saved are skipped,
+	// and bodies that have been added since keep their current state.
+	LocalVector<GodotBody3D *> active_bodies;
+	for (uint32_t i = 0; i < header.body_count; i++) {
+		GodotBody3D::Snapshot snapshot;
+		memcpy(&snapshot, r, sizeof(snapshot));
+		r += sizeof(snapshot);
+
+		GodotBody3D **body = bodies_by_rid.getptr(snapshot.self);
+		if (!body) {
+			continue;
+		}
+
+		(*body)->restore_snapshot(snapshot);
+		(*body)->set_active(false);
+		if (snapshot.active) {
+			active_bodies.push_back(*body);
+		}
+	}
+
+	// Every restored body is out of the active list by now. Activating adds to the front
+	// of the list, so walk the saved order backwards to put the list back as it was.
+	for (int64_t i = (int64_t)active_bodies.size() - 1; i >= 0; i--) {
+		active_bodies[i]->set_active(true);
+	}
+
+	HashMap<GodotBodyPair3D::SnapshotKey, const uint8_t *, GodotBodyPair3D::SnapshotKey> pair_snapshots;
+	for (uint32_t i = 0; i < header.pair_count; i++) {
+		GodotBodyPair3D::SnapshotKey key;
+		memcpy(&key, r + offsetof(GodotBodyPair3D::Snapshot, key), sizeof(key));
+		pair_snapshots.insert(key, r);
+		r += sizeof(GodotBodyPair3D::Snapshot);
+	}
+
+	// Pairs are owned by the broadphase, so only the contacts of pairs that exist right now can be restored.
+	// Others start from an empty contact cache, as new pairs do.
+	for (const KeyValue<RID, GodotBody3D *> &E : bodies_by_rid) {
+		for (const KeyValue<GodotConstraint3D *, int> &C : E.value->get_constraint_map()) {
+			GodotBodyPair3D *pair = C.key->get_body_pair();
+			if (!pair || C.value != 0) {
+				continue;
+			}
+
+			const uint8_t *const *pair_snapshot = pair_snapshots.getptr(pair->get_snapshot_key());
+			if (pair_snapshot) {
+				GodotBodyPair3D::Snapshot snapshot;
+				memcpy(&snapshot, *pair_snapshot, sizeof(snapshot));
+				pair->restore_snapshot(snapshot);
+			} else {
+				pair->clear_snapshot();
+			}
+		}
+	}
+
+	return true;
+}
+
 void GodotSpace3D::lock() {
 	locked = true;
 }
@@ -1262,6 +1522,8 @@ GodotSpace3D::GodotSpace3D() {
 	contact_max_separation = GLOBAL_GET("physics/3d/solver/contact_max_separation");
 	contact_max_allowed_penetration = GLOBAL_GET("physics/3d/solver/contact_max_allowed_penetration");
 	contact_bias = GLOBAL_GET("physics/3d/solver/default_contact_bias");
+	split_large_islands = GLOBAL_GET("physics/3d/solver/split_large_islands");
+	packed_contact_solver = GLOBAL_GET("physics/3d/solver/packed_contact_solver");
 
 	broadphase = GodotBroadPhase3D::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
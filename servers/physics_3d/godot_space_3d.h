@@ -46,11 +46,23 @@
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		const Vector3 *from = nullptr;
+		const Vector3 *to = nullptr;
+		RayResult *results = nullptr;
+		bool *hits = nullptr;
+	};
+
+	bool _intersect_ray_candidates(const RayParameters &p_parameters, const Vector3 &p_from, const Vector3 &p_to, GodotCollisionObject3D *const *p_objects, const int *p_subindices, int p_amount, RayResult &r_result) const;
+	void _intersect_ray_batch(uint32_t p_index, RayBatch *p_batch);
+
 public:
 	GodotSpace3D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) override;
@@ -99,6 +111,8 @@ private:
 	real_t contact_max_separation = 0.0;
 	real_t contact_max_allowed_penetration = 0.0;
 	real_t contact_bias = 0.0;
+	bool split_large_islands = true;
+	bool packed_contact_solver = false;
 
 	enum {
 		INTERSECTION_QUERY_MAX = 2048
@@ -126,7 +140,16 @@ private:
 
 	friend class GodotPhysicsDirectSpaceState3D;
 
-	int _cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb);
+	// Unfiltered broadphase results of the last motion test, reused by the next motion tests of the same body
+	// until another object enters, leaves or moves in the broadphase.
+	const GodotBody3D *motion_cull_body = nullptr;
+	AABB motion_cull_aabb;
+	LocalVector<GodotCollisionObject3D *> motion_cull_objects;
+	LocalVector<int> motion_cull_subindices;
+
+	int _filter_results_for_body(GodotBody3D *p_body, int p_amount);
+	int _cull_aabb_for_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, const AABB &p_aabb, bool &r_complete);
+	int _select_motion_candidates(const AABB &p_aabb, int p_amount, int *r_candidates) const;
 
 public:
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
@@ -135,6 +158,13 @@ public:
 	void set_default_area(GodotArea3D *p_area) { area = p_area; }
 	GodotArea3D *get_default_area() const { return area; }
 
+	// Called when the broadphase entries of an object change. p_moved is true if they only moved.
+	_FORCE_INLINE_ void broadphase_changed(const GodotCollisionObject3D *p_object, bool p_moved) {
+		if (!p_moved || p_object != motion_cull_body) {
+			motion_cull_body = nullptr;
+		}
+	}
+
 	const SelfList<GodotBody3D>::List &get_active_body_list() const;
 	void body_add_to_active_list(SelfList<GodotBody3D> *p_body);
 	void body_remove_from_active_list(SelfList<GodotBody3D> *p_body);
@@ -165,6 +195,8 @@ public:
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
 	_FORCE_INLINE_ real_t get_contact_max_allowed_penetration() const { return contact_max_allowed_penetration; }
 	_FORCE_INLINE_ real_t get_contact_bias() const { return contact_bias; }
+	_FORCE_INLINE_ bool is_split_large_islands_enabled() const { return split_large_islands; }
+	_FORCE_INLINE_ bool is_packed_contact_solver_enabled() const { return packed_contact_solver; }
 	_FORCE_INLINE_ real_t get_body_linear_velocity_sleep_threshold() const { return body_linear_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_angular_velocity_sleep_threshold() const { return body_angular_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_time_to_sleep() const { return body_time_to_sleep; }
@@ -211,6 +243,9 @@ public:
 
 	bool test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result);
 
+	Vector<uint8_t> save_state() const;
+	bool restore_state(const Vector<uint8_t> &p_state);
+
 	GodotSpace3D();
 	~GodotSpace3D();
 };
@@ -32,6 +32,7 @@
 
 #include "godot_joint_3d.h"
 
+#include "core/debugger/trace_profiler.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
@@ -40,6 +41,8 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define LARGE_ISLAND_CONSTRAINT_COUNT 512
+#define BATCH_PARALLEL_MIN_SIZE 64
 
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -158,6 +161,160 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	}
 }
 
+void GodotStep3D::_split_island(const LocalVector<GodotConstraint3D *> &p_constraint_island, ConstraintBatches &r_batches, bool p_pack_body_pairs) {
+	// Greedy coloring: each constraint goes to the first batch none of its dynamic bodies is part of yet.
+	// Static and kinematic bodies are only read by the solver, so they can be shared across a batch.
+	if (r_batches.colored.size() < 64) {
+		r_batches.colored.resize(64);
+		r_batches.colored_pairs.resize(64);
+		r_batches.packs.resize(64);
+	}
+	for (uint32_t batch_index = 0; batch_index < r_batches.colored_count; ++batch_index) {
+		r_batches.colored[batch_index].clear();
+		r_batches.colored_pairs[batch_index].clear();
+	}
+	r_batches.colored_count = 0;
+	r_batches.serial.clear();
+
+	body_batch_masks.clear();
+
+	uint32_t constraint_count = p_constraint_island.size();
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		GodotConstraint3D *constraint = p_constraint_island[constraint_index];
+
+		if (constraint->get_soft_body_count() > 0) {
+			// Soft bodies aren't tracked, keep these on the calling thread.
+			r_batches.serial.push_back(constraint);
+			continue;
+		}
+
+		uint64_t used_batches = 0;
+		GodotBody3D **bodies = constraint->get_body_ptr();
+		int body_count = constraint->get_body_count();
+		for (int i = 0; i < body_count; i++) {
+			if (bodies[i]->get_mode() <= PhysicsServer3D::BODY_MODE_KINEMATIC) {
+				continue;
+			}
+			const uint64_t *mask = body_batch_masks.getptr(bodies[i]);
+			if (mask) {
+				used_batches |= *mask;
+			}
+		}
+
+		if (used_batches == UINT64_MAX) {
+			r_batches.serial.push_back(constraint);
+			continue;
+		}
+
+		uint32_t batch_index = 0;
+		while (used_batches & (uint64_t(1) << batch_index)) {
+			batch_index++;
+		}
+
+		for (int i = 0; i < body_count; i++) {
+			if (bodies[i]->get_mode() <= PhysicsServer3D::BODY_MODE_KINEMATIC) {
+				continue;
+			}
+			uint64_t *mask = body_batch_masks.getptr(bodies[i]);
+			if (mask) {
+				*mask |= uint64_t(1) << batch_index;
+			} else {
+				body_batch_masks.insert(bodies[i], uint64_t(1) << batch_index);
+			}
+		}
+
+		GodotBodyPair3D *body_pair = p_pack_body_pairs ? constraint->get_body_pair() : nullptr;
+		if (body_pair) {
+			r_batches.colored_pairs[batch_index].push_back(body_pair);
+		} else {
+			r_batches.colored[batch_index].push_back(constraint);
+		}
+		r_batches.colored_count = MAX(r_batches.colored_count, batch_index + 1);
+	}
+}
+
+void GodotStep3D::_solve_batch_constraint(uint32_t p_constraint_index, LocalVector<GodotConstraint3D *> *p_batch) {
+	(*p_batch)[p_constraint_index]->solve(delta);
+}
+
+void GodotStep3D::_solve_pack_group(uint32_t p_group_index, GodotBodyPairPack3D *p_pack) {
+	p_pack->solve_group(p_group_index, delta);
+}
+
+void GodotStep3D::_solve_large_island(ConstraintBatches &p_batches) {
+	// Same iteration and priority scheme as _solve_island, one batch at a time.
+	int current_priority = 1;
+
+	uint32_t constraint_count = p_batches.serial.size();
+	bool solve_packs = false;
+	for (uint32_t batch_index = 0; batch_index < p_batches.colored_count; ++batch_index) {
+		constraint_count += p_batches.colored[batch_index].size();
+		if (!p_batches.colored_pairs[batch_index].is_empty()) {
+			p_batches.packs[batch_index].pack(p_batches.colored_pairs[batch_index]);
+			solve_packs = true;
+		}
+	}
+
+	while (constraint_count > 0 || solve_packs) {
+		for (int i = 0; i < iterations; i++) {
+			for (uint32_t batch_index = 0; batch_index < p_batches.colored_count; ++batch_index) {
+				if (solve_packs) {
+					GodotBodyPairPack3D &pack = p_batches.packs[batch_index];
+					uint32_t group_count = pack.get_group_count();
+					if (group_count < BATCH_PARALLEL_MIN_SIZE / 4) {
+						for (uint32_t group_index = 0; group_index < group_count; ++group_index) {
+							pack.solve_group(group_index, delta);
+						}
+					} else {
+						WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_pack_group, &pack, group_count, -1, true, SNAME("Physics3DContactSolvePack"));
+						WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+					}
+				}
+
+				LocalVector<GodotConstraint3D *> &batch = p_batches.colored[batch_index];
+				uint32_t batch_size = batch.size();
+				if (batch_size < BATCH_PARALLEL_MIN_SIZE) {
+					for (uint32_t constraint_index = 0; constraint_index < batch_size; ++constraint_index) {
+						batch[constraint_index]->solve(delta);
+					}
+				} else {
+					WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_batch_constraint, &batch, batch_size, -1, true, SNAME("Physics3DConstraintSolveBatch"));
+					WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+				}
+			}
+
+			for (GodotConstraint3D *constraint : p_batches.serial) {
+				constraint->solve(delta);
+			}
+		}
+
+		if (solve_packs) {
+			// Body pairs always have the default priority, so they are done after the first round.
+			for (uint32_t batch_index = 0; batch_index < p_batches.colored_count; ++batch_index) {
+				p_batches.packs[batch_index].unpack();
+			}
+			solve_packs = false;
+		}
+
+		// Check priority to keep only higher priority constraints.
+		++current_priority;
+		constraint_count = 0;
+		for (uint32_t batch_index = 0; batch_index < p_batches.colored_count + 1; ++batch_index) {
+			LocalVector<GodotConstraint3D *> &batch = batch_index < p_batches.colored_count ? p_batches.colored[batch_index] : p_batches.serial;
+			uint32_t priority_constraint_count = 0;
+			for (uint32_t constraint_index = 0; constraint_index < batch.size(); ++constraint_index) {
+				GodotConstraint3D *constraint = batch[constraint_index];
+				if (constraint->get_priority() >= current_priority) {
+					// Keep this constraint for the next iteration.
+					batch[priority_constraint_count++] = constraint;
+				}
+			}
+			batch.resize(priority_constraint_count);
+			constraint_count += priority_constraint_count;
+		}
+	}
+}
+
 void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
 	bool can_sleep = true;
 
@@ -183,6 +340,8 @@ void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island
 }
 
 void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
+	TRACE_SCOPE("GodotStep3D::step");
+
 	p_space->lock(); // can't access space during this
 
 	p_space->setup(); //update inertias, etc
@@ -360,11 +519,35 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		_pre_solve_island(constraint_islands[island_index]);
 	}
 
+	/* SPLIT LARGE CONSTRAINT ISLANDS */
+
+	// A single huge island would otherwise keep one worker busy while the others are idle.
+	// Its constraints are moved to batches, leaving an empty island for _solve_island.
+	uint32_t large_island_count = 0;
+	for (uint32_t island_index = 0; p_space->is_split_large_islands_enabled() && island_index < island_count; ++island_index) {
+		LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_index];
+		if (constraint_island.size() < LARGE_ISLAND_CONSTRAINT_COUNT) {
+			continue;
+		}
+		++large_island_count;
+		if (large_islands.size() < large_island_count) {
+			large_islands.resize(large_island_count);
+		}
+		_split_island(constraint_island, large_islands[large_island_count - 1], p_space->is_packed_contact_solver_enabled());
+		constraint_island.clear();
+	}
+
 	/* SOLVE CONSTRAINT ISLANDS */
 
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
 	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
+
+	// Large islands are solved batch by batch from here, while the workers handle the other islands.
+	for (uint32_t island_index = 0; island_index < large_island_count; ++island_index) {
+		_solve_large_island(large_islands[island_index]);
+	}
+
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -31,8 +31,10 @@
 #ifndef GODOT_STEP_3D_H
 #define GODOT_STEP_3D_H
 
+#include "godot_body_pair_3d.h"
 #include "godot_space_3d.h"
 
+#include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
 
 class GodotStep3D {
@@ -45,11 +47,29 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
 
+	// Large islands are split into batches of constraints that don't share any
+	// dynamic body, so that the constraints of one batch can be solved in parallel.
+	struct ConstraintBatches {
+		LocalVector<LocalVector<GodotConstraint3D *>> colored;
+		// Body pairs of each batch, when they are solved in packs instead.
+		LocalVector<LocalVector<GodotBodyPair3D *>> colored_pairs;
+		LocalVector<GodotBodyPairPack3D> packs;
+		uint32_t colored_count = 0;
+		LocalVector<GodotConstraint3D *> serial; // Constraints that couldn't be batched.
+	};
+
+	LocalVector<ConstraintBatches> large_islands;
+	HashMap<const GodotBody3D *, uint64_t> body_batch_masks;
+
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _split_island(const LocalVector<GodotConstraint3D *> &p_constraint_island, ConstraintBatches &r_batches, bool p_pack_body_pairs);
+	void _solve_batch_constraint(uint32_t p_constraint_index, LocalVector<GodotConstraint3D *> *p_batch);
+	void _solve_pack_group(uint32_t p_group_index, GodotBodyPairPack3D *p_pack);
+	void _solve_large_island(ConstraintBatches &p_batches);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
@@ -276,6 +276,9 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	virtual Vector<uint8_t> space_save_state(RID p_space) const = 0;
+	virtual bool space_restore_state(RID p_space, const Vector<uint8_t> &p_state) = 0;
+
 	//missing space parameters
 
 	/* AREA API */
@@ -371,6 +371,74 @@ Dictionary PhysicsDirectSpaceState3D::_intersect_ray(const Ref<PhysicsRayQueryPa
 	return d;
 }
 
+void PhysicsDirectSpaceState3D::intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits) {
+	RayParameters parameters = p_parameters;
+	for (int i = 0; i < p_count; i++) {
+		parameters.from = p_from[i];
+		parameters.to = p_to[i];
+		r_hits[i] = intersect_ray(parameters, r_results[i]);
+	}
+}
+
+Dictionary PhysicsDirectSpaceState3D::_intersect_rays(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to) {
+	ERR_FAIL_COND_V(!p_ray_query.is_valid(), Dictionary());
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), Dictionary(), "The 'from' and 'to' arrays must have the same size.");
+
+	int count = p_from.size();
+
+	Vector<RayResult> results;
+	results.resize(count);
+	Vector<uint8_t> hits;
+	hits.resize(count);
+	static_assert(sizeof(bool) == sizeof(uint8_t));
+
+	intersect_rays(p_ray_query->get_parameters(), p_from.ptr(), p_to.ptr(), count, results.ptrw(), reinterpret_cast<bool *>(hits.ptrw()));
+
+	PackedVector3Array positions;
+	positions.resize(count);
+	PackedVector3Array normals;
+	normals.resize(count);
+	PackedInt64Array collider_ids;
+	collider_ids.resize(count);
+	PackedInt32Array shapes;
+	shapes.resize(count);
+	PackedInt32Array face_indices;
+	face_indices.resize(count);
+
+	Vector3 *positions_ptr = positions.ptrw();
+	Vector3 *normals_ptr = normals.ptrw();
+	int64_t *collider_ids_ptr = collider_ids.ptrw();
+	int32_t *shapes_ptr = shapes.ptrw();
+	int32_t *face_indices_ptr = face_indices.ptrw();
+	const RayResult *results_ptr = results.ptr();
+	const uint8_t *hits_ptr = hits.ptr();
+
+	for (int i = 0; i < count; i++) {
+		if (hits_ptr[i]) {
+			positions_ptr[i] = results_ptr[i].position;
+			normals_ptr[i] = results_ptr[i].normal;
+			collider_ids_ptr[i] = (int64_t)(uint64_t)results_ptr[i].collider_id;
+			shapes_ptr[i] = results_ptr[i].shape;
+			face_indices_ptr[i] = results_ptr[i].face_index;
+		} else {
+			positions_ptr[i] = p_to[i];
+			normals_ptr[i] = Vector3();
+			collider_ids_ptr[i] = 0;
+			shapes_ptr[i] = -1;
+			face_indices_ptr[i] = -1;
+		}
+	}
+
+	Dictionary d;
+	d["position"] = positions;
+	d["normal"] = normals;
+	d["collider_id"] = collider_ids;
+	d["shape"] = shapes;
+	d["face_index"] = face_indices;
+
+	return d;
+}
+
 TypedArray<Dictionary> PhysicsDirectSpaceState3D::_intersect_point(const Ref<PhysicsPointQueryParameters3D> &p_point_query, int p_max_results) {
 	ERR_FAIL_COND_V(p_point_query.is_null(), TypedArray<Dictionary>());
 
@@ -476,6 +544,7 @@ PhysicsDirectSpaceState3D::PhysicsDirectSpaceState3D() {
 void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_point", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_point, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("intersect_ray", "parameters"), &PhysicsDirectSpaceState3D::_intersect_ray);
+	ClassDB::bind_method(D_METHOD("intersect_rays", "parameters", "from", "to"), &PhysicsDirectSpaceState3D::_intersect_rays);
 	ClassDB::bind_method(D_METHOD("intersect_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState3D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
@@ -681,6 +750,30 @@ RID PhysicsServer3D::shape_create(ShapeType p_shape) {
 	}
 }
 
+void PhysicsServer3D::bodies_set_state(const Vector<RID> &p_bodies, BodyState p_state, const Vector<Variant> &p_values) {
+	ERR_FAIL_COND_MSG(p_bodies.size() != p_values.size(), "The bodies and values arrays must have the same size.");
+
+	for (int i = 0; i < p_bodies.size(); i++) {
+		body_set_state(p_bodies[i], p_state, p_values[i]);
+	}
+}
+
+void PhysicsServer3D::_bodies_set_state(const TypedArray<RID> &p_bodies, BodyState p_state, const Array &p_values) {
+	ERR_FAIL_COND_MSG(p_bodies.size() != p_values.size(), "The bodies and values arrays must have the same size.");
+
+	Vector<RID> bodies;
+	bodies.resize(p_bodies.size());
+	Vector<Variant> values;
+	values.resize(p_values.size());
+
+	for (int i = 0; i < p_bodies.size(); i++) {
+		bodies.write[i] = p_bodies[i];
+		values.write[i] = p_values[i];
+	}
+
+	bodies_set_state(bodies, p_state, values);
+}
+
 void PhysicsServer3D::_bind_methods() {
 #ifndef _3D_DISABLED
 
@@ -705,6 +798,8 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_is_active", "space"), &PhysicsServer3D::space_is_active);
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer3D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer3D::space_get_param);
+	ClassDB::bind_method(D_METHOD("space_save_state", "space"), &PhysicsServer3D::space_save_state);
+	ClassDB::bind_method(D_METHOD("space_restore_state", "space", "state"), &PhysicsServer3D::space_restore_state);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer3D::space_get_direct_state);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer3D::area_create);
@@ -786,6 +881,7 @@ void PhysicsServer3D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("body_set_state", "body", "state", "value"), &PhysicsServer3D::body_set_state);
 	ClassDB::bind_method(D_METHOD("body_get_state", "body", "state"), &PhysicsServer3D::body_get_state);
+	ClassDB::bind_method(D_METHOD("bodies_set_state", "bodies", "state", "values"), &PhysicsServer3D::_bodies_set_state);
 
 	ClassDB::bind_method(D_METHOD("body_apply_central_impulse", "body", "impulse"), &PhysicsServer3D::body_apply_central_impulse);
 	ClassDB::bind_method(D_METHOD("body_apply_impulse", "body", "impulse", "position"), &PhysicsServer3D::body_apply_impulse, Vector3());
@@ -1065,6 +1161,8 @@ PhysicsServer3D::PhysicsServer3D() {
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_separation", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.05);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_allowed_penetration", PROPERTY_HINT_RANGE, "0.001,0.1,0.001,or_greater"), 0.01);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/default_contact_bias", PROPERTY_HINT_RANGE, "0,1,0.01"), 0.8);
+	GLOBAL_DEF("physics/3d/solver/split_large_islands", true);
+	GLOBAL_DEF("physics/3d/solver/packed_contact_solver", false);
 }
 
 PhysicsServer3D::~PhysicsServer3D() {
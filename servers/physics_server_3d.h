@@ -122,6 +122,7 @@ class PhysicsDirectSpaceState3D : public Object {
 
 private:
 	Dictionary _intersect_ray(const Ref<PhysicsRayQueryParameters3D> &p_ray_query);
+	Dictionary _intersect_rays(const Ref<PhysicsRayQueryParameters3D> &p_ray_query, const PackedVector3Array &p_from, const PackedVector3Array &p_to);
 	TypedArray<Dictionary> _intersect_point(const Ref<PhysicsPointQueryParameters3D> &p_point_query, int p_max_results = 32);
 	TypedArray<Dictionary> _intersect_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results = 32);
 	Vector<real_t> _cast_motion(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
@@ -158,6 +159,9 @@ public:
 	};
 
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) = 0;
+	// Casts p_count rays sharing the same parameters, except for their origin and end points.
+	// r_hits[i] tells whether r_results[i] is valid.
+	virtual void intersect_rays(const RayParameters &p_parameters, const Vector3 *p_from, const Vector3 *p_to, int p_count, RayResult *r_results, bool *r_hits);
 
 	struct ShapeResult {
 		RID rid;
@@ -306,6 +310,9 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	virtual Vector<uint8_t> space_save_state(RID p_space) const = 0;
+	virtual bool space_restore_state(RID p_space, const Vector<uint8_t> &p_state) = 0;
+
 	//missing space parameters
 
 	/* AREA API */
@@ -464,6 +471,13 @@ public:
 	virtual void body_set_state(RID p_body, BodyState p_state, const Variant &p_variant) = 0;
 	virtual Variant body_get_state(RID p_body, BodyState p_state) const = 0;
 
+	// Sets the same state on many bodies, which threaded servers can queue as a single command.
+	virtual void bodies_set_state(const Vector<RID> &p_bodies, BodyState p_state, const Vector<Variant> &p_values);
+
+protected:
+	void _bodies_set_state(const TypedArray<RID> &p_bodies, BodyState p_state, const Array &p_values);
+
+public:
 	virtual void body_apply_central_impulse(RID p_body, const Vector3 &p_impulse) = 0;
 	virtual void body_apply_impulse(RID p_body, const Vector3 &p_impulse, const Vector3 &p_position = Vector3()) = 0;
 	virtual void body_apply_torque_impulse(RID p_body, const Vector3 &p_impulse) = 0;
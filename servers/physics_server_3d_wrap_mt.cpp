@@ -31,16 +31,141 @@
 #include "physics_server_3d_wrap_mt.h"
 
 #include "core/os/os.h"
+#include "core/templates/local_vector.h"
 
 void PhysicsServer3DWrapMT::thread_exit() {
 	exit = true;
 }
 
-void PhysicsServer3DWrapMT::thread_step(real_t p_delta) {
+void PhysicsServer3DWrapMT::thread_step(real_t p_delta, uint64_t p_step) {
 	physics_server_3d->step(p_delta);
+	_update_body_state_cache(p_step);
 	step_sem.post();
 }
 
+void PhysicsServer3DWrapMT::_update_body_state_cache(uint64_t p_step) {
+	LocalVector<RID> bodies;
+	{
+		MutexLock lock(body_state_cache_mutex);
+		LocalVector<RID> unread;
+		for (KeyValue<RID, CachedBodyState> &E : body_state_cache) {
+			if (!E.value.read) {
+				unread.push_back(E.key);
+				continue;
+			}
+			E.value.read = false;
+			if (E.value.last_write_step < p_step) {
+				bodies.push_back(E.key);
+			}
+		}
+		for (const RID &body : unread) {
+			body_state_cache.erase(body);
+		}
+	}
+
+	// Read the new states without holding the lock, so that reads from other threads don't wait for them.
+	LocalVector<CachedBodyState> states;
+	states.resize(bodies.size());
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		CachedBodyState &state = states[i];
+		state.transform = physics_server_3d->body_get_state(bodies[i], BODY_STATE_TRANSFORM);
+		state.linear_velocity = physics_server_3d->body_get_state(bodies[i], BODY_STATE_LINEAR_VELOCITY);
+		state.angular_velocity = physics_server_3d->body_get_state(bodies[i], BODY_STATE_ANGULAR_VELOCITY);
+		state.sleeping = physics_server_3d->body_get_state(bodies[i], BODY_STATE_SLEEPING);
+		state.can_sleep = physics_server_3d->body_get_state(bodies[i], BODY_STATE_CAN_SLEEP);
+		state.valid = true;
+	}
+
+	MutexLock lock(body_state_cache_mutex);
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		CachedBodyState *cached = body_state_cache.getptr(bodies[i]);
+		if (!cached || cached->last_write_step >= p_step) {
+			// The body was freed, or a command for it was sent after this step was queued, so it hasn't run yet.
+			continue;
+		}
+
+		states[i].read = cached->read;
+		states[i].last_write_step = cached->last_write_step;
+		*cached = states[i];
+	}
+}
+
+void PhysicsServer3DWrapMT::_invalidate_body_state_cache(const RID &p_rid) {
+	if (!create_thread) {
+		return;
+	}
+
+	MutexLock lock(body_state_cache_mutex);
+	CachedBodyState *cached = body_state_cache.getptr(p_rid);
+	if (cached) {
+		cached->valid = false;
+		cached->last_write_step = queued_steps;
+	}
+}
+
+void PhysicsServer3DWrapMT::_invalidate_body_state_cache_all() {
+	if (!create_thread) {
+		return;
+	}
+
+	MutexLock lock(body_state_cache_mutex);
+	for (KeyValue<RID, CachedBodyState> &E : body_state_cache) {
+		E.value.valid = false;
+		E.value.last_write_step = queued_steps;
+	}
+}
+
+Variant PhysicsServer3DWrapMT::body_get_state(RID p_body, BodyState p_state) const {
+	if (Thread::get_caller_id() == server_thread) {
+		command_queue.flush_if_pending();
+		return physics_server_3d->body_get_state(p_body, p_state);
+	}
+
+	if (!create_thread) {
+		// There are no steps running in the background to copy states from, so the cache is never used.
+		Variant ret;
+		command_queue.push_and_ret(physics_server_3d, &PhysicsServer3D::body_get_state, p_body, p_state, &ret);
+		return ret;
+	}
+
+	{
+		MutexLock lock(body_state_cache_mutex);
+		CachedBodyState *cached = body_state_cache.getptr(p_body);
+		if (cached) {
+			cached->read = true;
+		}
+		if (cached && cached->valid) {
+			switch (p_state) {
+				case BODY_STATE_TRANSFORM:
+					return cached->transform;
+				case BODY_STATE_LINEAR_VELOCITY:
+					return cached->linear_velocity;
+				case BODY_STATE_ANGULAR_VELOCITY:
+					return cached->angular_velocity;
+				case BODY_STATE_SLEEPING:
+					return cached->sleeping;
+				case BODY_STATE_CAN_SLEEP:
+					return cached->can_sleep;
+			}
+		}
+	}
+
+	Variant ret;
+	command_queue.push_and_ret(physics_server_3d, &PhysicsServer3D::body_get_state, p_body, p_state, &ret);
+
+	if (ret.get_type() != Variant::NIL) {
+		// Keep a copy of this body's state from now on, starting with the next step.
+		MutexLock lock(body_state_cache_mutex);
+		if (!body_state_cache.has(p_body)) {
+			CachedBodyState cached;
+			cached.last_write_step = queued_steps;
+			body_state_cache.insert(p_body, cached);
+		}
+	}
+
+	return ret;
+}
+
 void PhysicsServer3DWrapMT::_thread_callback(void *_instance) {
 	PhysicsServer3DWrapMT *vsmt = reinterpret_cast<PhysicsServer3DWrapMT *>(_instance);
 
@@ -68,7 +193,12 @@ void PhysicsServer3DWrapMT::thread_loop() {
 
 void PhysicsServer3DWrapMT::step(real_t p_step) {
 	if (create_thread) {
-		command_queue.push(this, &PhysicsServer3DWrapMT::thread_step, p_step);
+		uint64_t step;
+		{
+			MutexLock lock(body_state_cache_mutex);
+			step = ++queued_steps;
+		}
+		command_queue.push(this, &PhysicsServer3DWrapMT::thread_step, p_step, step);
 	} else {
 		command_queue.flush_all(); //flush all pending from other threads
 		physics_server_3d->step(p_step);
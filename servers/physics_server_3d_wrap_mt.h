@@ -32,8 +32,10 @@
 #define PHYSICS_SERVER_3D_WRAP_MT_H
 
 #include "core/config/project_settings.h"
+#include "core/os/mutex.h"
 #include "core/os/thread.h"
 #include "core/templates/command_queue_mt.h"
+#include "core/templates/hash_map.h"
 #include "servers/physics_server_3d.h"
 
 #ifdef DEBUG_SYNC
@@ -58,7 +60,7 @@ class PhysicsServer3DWrapMT : public PhysicsServer3D {
 	bool create_thread = false;
 
 	Semaphore step_sem;
-	void thread_step(real_t p_delta);
+	void thread_step(real_t p_delta, uint64_t p_step);
 
 	void thread_exit();
 
@@ -67,6 +69,29 @@ class PhysicsServer3DWrapMT : public PhysicsServer3D {
 	Mutex alloc_mutex;
 	int pool_max_size = 0;
 
+	// Body states read from other threads are served from a copy made by the physics thread after each step,
+	// so that reading them doesn't have to wait for the step to end. Commands that change a body's state drop its copy,
+	// which only becomes valid again after a step that ran after that command. Copies that weren't read since
+	// the previous step are dropped, so bodies that stopped being read don't keep being copied.
+	struct CachedBodyState {
+		Transform3D transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		bool sleeping = false;
+		bool can_sleep = true;
+		bool valid = false;
+		bool read = true;
+		uint64_t last_write_step = 0;
+	};
+
+	mutable HashMap<RID, CachedBodyState> body_state_cache;
+	mutable BinaryMutex body_state_cache_mutex;
+	uint64_t queued_steps = 0;
+
+	void _update_body_state_cache(uint64_t p_step);
+	void _invalidate_body_state_cache(const RID &p_rid);
+	void _invalidate_body_state_cache_all();
+
 public:
 #define ServerName PhysicsServer3D
 #define ServerNameWrapMT PhysicsServer3DWrapMT
@@ -129,6 +154,20 @@ public:
 		return physics_server_3d->space_get_contact_count(p_space);
 	}
 
+	FUNC1RC(Vector<uint8_t>, space_save_state, RID);
+	virtual bool space_restore_state(RID p_space, const Vector<uint8_t> &p_state) override {
+		_invalidate_body_state_cache_all();
+		if (Thread::get_caller_id() != server_thread) {
+			bool ret;
+			command_queue.push_and_ret(physics_server_3d, &PhysicsServer3D::space_restore_state, p_space, p_state, &ret);
+			SYNC_DEBUG
+			return ret;
+		} else {
+			command_queue.flush_if_pending();
+			return physics_server_3d->space_restore_state(p_space, p_state);
+		}
+	}
+
 	/* AREA API */
 
 	//FUNC0RID(area);
@@ -174,10 +213,26 @@ public:
 	//FUNC2RID(body,BodyMode,bool);
 	FUNCRID(body)
 
-	FUNC2(body_set_space, RID, RID);
+	virtual void body_set_space(RID p_body, RID p_space) override {
+		_invalidate_body_state_cache(p_body);
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.push(physics_server_3d, &PhysicsServer3D::body_set_space, p_body, p_space);
+		} else {
+			command_queue.flush_if_pending();
+			physics_server_3d->body_set_space(p_body, p_space);
+		}
+	}
 	FUNC1RC(RID, body_get_space, RID);
 
-	FUNC2(body_set_mode, RID, BodyMode);
+	virtual void body_set_mode(RID p_body, BodyMode p_mode) override {
+		_invalidate_body_state_cache(p_body);
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.push(physics_server_3d, &PhysicsServer3D::body_set_mode, p_body, p_mode);
+		} else {
+			command_queue.flush_if_pending();
+			physics_server_3d->body_set_mode(p_body, p_mode);
+		}
+	}
 	FUNC1RC(BodyMode, body_get_mode, RID);
 
 	FUNC4(body_add_shape, RID, RID, const Transform3D &, bool);
@@ -216,12 +271,58 @@ public:
 
 	FUNC1(body_reset_mass_properties, RID);
 
-	FUNC3(body_set_state, RID, BodyState, const Variant &);
-	FUNC2RC(Variant, body_get_state, RID, BodyState);
+	virtual void body_set_state(RID p_body, BodyState p_state, const Variant &p_variant) override {
+		_invalidate_body_state_cache(p_body);
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.push(physics_server_3d, &PhysicsServer3D::body_set_state, p_body, p_state, p_variant);
+		} else {
+			command_queue.flush_if_pending();
+			physics_server_3d->body_set_state(p_body, p_state, p_variant);
+		}
+	}
+	virtual Variant body_get_state(RID p_body, BodyState p_state) const override;
+
+	virtual void bodies_set_state(const Vector<RID> &p_bodies, BodyState p_state, const Vector<Variant> &p_values) override {
+		for (const RID &body : p_bodies) {
+			_invalidate_body_state_cache(body);
+		}
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.push(physics_server_3d, &PhysicsServer3D::bodies_set_state, p_bodies, p_state, p_values);
+		} else {
+			command_queue.flush_if_pending();
+			physics_server_3d->bodies_set_state(p_bodies, p_state, p_values);
+		}
+	}
 
-	FUNC2(body_apply_torque_impulse, RID, const Vector3 &);
-	FUNC2(body_apply_central_impulse, RID, const Vector3 &);
-	FUNC3(body_apply_impulse, RID, const Vector3 &, const Vector3 &);
+	virtual void body_apply_torque_impulse(RID p_body, const Vector3 &p_impulse) override {
+		_invalidate_body_state_cache(p_body);
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.push(physics_server_3d, &PhysicsServer3D::body_apply_torque_impulse, p_body, p_impulse);
+		} else {
+			command_queue.flush_if_pending();
+			physics_server_3d->body_apply_torque_impulse(p_body, p_impulse);
+		}
+	}
+
+	virtual void body_apply_central_impulse(RID p_body, const Vector3 &p_impulse) override {
+		_invalidate_body_state_cache(p_body);
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.push(physics_server_3d, &PhysicsServer3D::body_apply_central_impulse, p_body, p_impulse);
+		} else {
+			command_queue.flush_if_pending();
+			physics_server_3d->body_apply_central_impulse(p_body, p_impulse);
+		}
+	}
+
+	virtual void body_apply_impulse(RID p_body, const Vector3 &p_impulse, const Vector3 &p_position = Vector3()) override {
+		_invalidate_body_state_cache(p_body);
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.push(physics_server_3d, &PhysicsServer3D::body_apply_impulse, p_body, p_impulse, p_position);
+		} else {
+			command_queue.flush_if_pending();
+			physics_server_3d->body_apply_impulse(p_body, p_impulse, p_position);
+		}
+	}
 
 	FUNC2(body_apply_central_force, RID, const Vector3 &);
 	FUNC3(body_apply_force, RID, const Vector3 &, const Vector3 &);
@@ -237,9 +338,25 @@ public:
 	FUNC2(body_set_constant_torque, RID, const Vector3 &);
 	FUNC1RC(Vector3, body_get_constant_torque, RID);
 
-	FUNC2(body_set_axis_velocity, RID, const Vector3 &);
+	virtual void body_set_axis_velocity(RID p_body, const Vector3 &p_axis_velocity) override {
+		_invalidate_body_state_cache(p_body);
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.push(physics_server_3d, &PhysicsServer3D::body_set_axis_velocity, p_body, p_axis_velocity);
+		} else {
+			command_queue.flush_if_pending();
+			physics_server_3d->body_set_axis_velocity(p_body, p_axis_velocity);
+		}
+	}
 
-	FUNC3(body_set_axis_lock, RID, BodyAxis, bool);
+	virtual void body_set_axis_lock(RID p_body, BodyAxis p_axis, bool p_lock) override {
+		_invalidate_body_state_cache(p_body);
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.push(physics_server_3d, &PhysicsServer3D::body_set_axis_lock, p_body, p_axis, p_lock);
+		} else {
+			command_queue.flush_if_pending();
+			physics_server_3d->body_set_axis_lock(p_body, p_axis, p_lock);
+		}
+	}
 	FUNC2RC(bool, body_is_axis_locked, RID, BodyAxis);
 
 	FUNC2(body_add_collision_exception, RID, RID);
@@ -380,7 +497,18 @@ public:
 
 	/* MISC */
 
-	FUNC1(free, RID);
+	virtual void free(RID p_rid) override {
+		if (create_thread) {
+			MutexLock lock(body_state_cache_mutex);
+			body_state_cache.erase(p_rid);
+		}
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.push(physics_server_3d, &PhysicsServer3D::free, p_rid);
+		} else {
+			command_queue.flush_if_pending();
+			physics_server_3d->free(p_rid);
+		}
+	}
 	FUNC1(set_active, bool);
 
 	virtual void init() override;
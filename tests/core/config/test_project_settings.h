@@ -33,6 +33,8 @@
 
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
 #include "core/variant/variant.h"
 #include "tests/test_macros.h"
 
@@ -41,6 +43,21 @@ public:
 	static String &resource_path() {
 		return ProjectSettings::get_singleton()->resource_path;
 	};
+	static Error load_settings_text_or_binary(const String &p_text_path, const String &p_bin_path) {
+		return ProjectSettings::get_singleton()->_load_settings_text_or_binary(p_text_path, p_bin_path);
+	};
+	static bool &boot_image_loaded() {
+		return ProjectSettings::get_singleton()->boot_image_loaded;
+	};
+	static bool &boot_image_dirty() {
+		return ProjectSettings::get_singleton()->boot_image_dirty;
+	};
+	static List<Pair<String, Variant>> &boot_image_settings() {
+		return ProjectSettings::get_singleton()->boot_image_settings;
+	};
+	static uint64_t &last_save_time() {
+		return ProjectSettings::get_singleton()->last_save_time;
+	};
 };
 
 namespace TestProjectSettings {
@@ -157,6 +174,104 @@ TEST_CASE("[ProjectSettings] localize_path") {
 	TestProjectSettingsInternalsAccessor::resource_path() = old_resource_path;
 }
 
+TEST_CASE("[ProjectSettings] Boot image") {
+	ProjectSettings *ps = ProjectSettings::get_singleton();
+	const String dir = OS::get_singleton()->get_cache_path().path_join("boot_image_test");
+	DirAccess::make_dir_recursive_absolute(dir);
+	const String text_path = dir.path_join("project.godot");
+	const String bin_path = dir.path_join("project.binary");
+	const String override_path = dir.path_join("override.cfg");
+	const String image_path = dir.path_join("boot_image.bin");
+	const uint64_t old_last_save_time = TestProjectSettingsInternalsAccessor::last_save_time();
+
+	// An old format project, the input action is converted on load.
+	Ref<FileAccess> f = FileAccess::open(text_path, FileAccess::WRITE);
+	f->store_string("config_version=3\n\n[application]\n\nconfig/boot_image_test=\"a\"\n\n[input]\n\nboot_image_test_action=[]\n");
+	f.unref();
+	DirAccess::remove_absolute(override_path);
+	DirAccess::remove_absolute(image_path);
+
+	ps->set_boot_image_path(image_path);
+	TestProjectSettingsInternalsAccessor::boot_image_loaded() = false;
+	TestProjectSettingsInternalsAccessor::boot_image_dirty() = false;
+
+	SUBCASE("Settings come from the project file when there is no image") {
+		CHECK_EQ(TestProjectSettingsInternalsAccessor::load_settings_text_or_binary(text_path, bin_path), OK);
+		CHECK_FALSE(TestProjectSettingsInternalsAccessor::boot_image_loaded());
+		CHECK(TestProjectSettingsInternalsAccessor::boot_image_dirty());
+		CHECK_EQ(ps->get_setting("application/config/boot_image_test"), Variant("a"));
+		CHECK_EQ(ps->get_setting("input/boot_image_test_action").get_type(), Variant::DICTIONARY);
+		// Only the values from the file are captured, not the defaults.
+		CHECK_EQ(TestProjectSettingsInternalsAccessor::boot_image_settings().size(), 2);
+	}
+
+	SUBCASE("The image restores the settings and converts them the same way") {
+		CHECK_EQ(TestProjectSettingsInternalsAccessor::load_settings_text_or_binary(text_path, bin_path), OK);
+		CHECK_EQ(ps->save_boot_image(), OK);
+		ps->set_setting("application/config/boot_image_test", Variant());
+		ps->set_setting("input/boot_image_test_action", Variant());
+		TestProjectSettingsInternalsAccessor::last_save_time() = 0;
+
+		CHECK_EQ(TestProjectSettingsInternalsAccessor::load_settings_text_or_binary(text_path, bin_path), OK);
+		CHECK(TestProjectSettingsInternalsAccessor::boot_image_loaded());
+		CHECK_EQ(ps->get_setting("application/config/boot_image_test"), Variant("a"));
+		CHECK_EQ(ps->get_setting("input/boot_image_test_action").get_type(), Variant::DICTIONARY);
+		CHECK_EQ(TestProjectSettingsInternalsAccessor::last_save_time(), FileAccess::get_modified_time(ps->get_resource_path().path_join("project.godot")));
+	}
+
+	SUBCASE("A changed override.cfg invalidates the image") {
+		CHECK_EQ(TestProjectSettingsInternalsAccessor::load_settings_text_or_binary(text_path, bin_path), OK);
+		CHECK_EQ(ps->save_boot_image(), OK);
+
+		f = FileAccess::open(override_path, FileAccess::WRITE);
+		f->store_string("[application]\n\nconfig/boot_image_test=\"b\"\n");
+		f.unref();
+
+		TestProjectSettingsInternalsAccessor::boot_image_loaded() = false;
+		CHECK_EQ(TestProjectSettingsInternalsAccessor::load_settings_text_or_binary(text_path, bin_path), OK);
+		CHECK_FALSE(TestProjectSettingsInternalsAccessor::boot_image_loaded());
+		CHECK(TestProjectSettingsInternalsAccessor::boot_image_dirty());
+	}
+
+	SUBCASE("A changed project file invalidates the image") {
+		CHECK_EQ(TestProjectSettingsInternalsAccessor::load_settings_text_or_binary(text_path, bin_path), OK);
+		CHECK_EQ(ps->save_boot_image(), OK);
+
+		f = FileAccess::open(text_path, FileAccess::WRITE);
+		f->store_string("config_version=5\n\n[application]\n\nconfig/boot_image_test=\"changed\"\n");
+		f.unref();
+
+		TestProjectSettingsInternalsAccessor::boot_image_loaded() = false;
+		CHECK_EQ(TestProjectSettingsInternalsAccessor::load_settings_text_or_binary(text_path, bin_path), OK);
+		CHECK_FALSE(TestProjectSettingsInternalsAccessor::boot_image_loaded());
+		CHECK_EQ(ps->get_setting("application/config/boot_image_test"), Variant("changed"));
+	}
+
+	SUBCASE("An image in an older format is rejected") {
+		f = FileAccess::open(image_path, FileAccess::WRITE);
+		uint8_t hdr[4] = { 'G', 'D', 'B', 'I' };
+		f->store_buffer(hdr, 4);
+		f->store_32(ProjectSettings::BOOT_IMAGE_VERSION - 1);
+		f.unref();
+
+		CHECK_EQ(TestProjectSettingsInternalsAccessor::load_settings_text_or_binary(text_path, bin_path), OK);
+		CHECK_FALSE(TestProjectSettingsInternalsAccessor::boot_image_loaded());
+		CHECK_EQ(ps->get_setting("application/config/boot_image_test"), Variant("a"));
+	}
+
+	ps->set_setting("application/config/boot_image_test", Variant());
+	ps->set_setting("input/boot_image_test_action", Variant());
+	ps->set_boot_image_path(String());
+	TestProjectSettingsInternalsAccessor::boot_image_loaded() = false;
+	TestProjectSettingsInternalsAccessor::boot_image_dirty() = false;
+	TestProjectSettingsInternalsAccessor::boot_image_settings().clear();
+	TestProjectSettingsInternalsAccessor::last_save_time() = old_last_save_time;
+	DirAccess::remove_absolute(text_path);
+	DirAccess::remove_absolute(override_path);
+	DirAccess::remove_absolute(image_path);
+	DirAccess::remove_absolute(dir);
+}
+
 } // namespace TestProjectSettings
 
 #endif // TEST_PROJECT_SETTINGS_H
@@ -0,0 +1,104 @@
+/**************************************************************************/
+/*  test_main_timer_sync.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#ifndef TEST_MAIN_TIMER_SYNC_H
+#define TEST_MAIN_TIMER_SYNC_H
+
+#include "core/os/os.h"
+#include "main/main_timer_sync.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMainTimerSync {
+
+static const int TICKS_PER_SECOND = 60;
+static const double PHYSICS_STEP = 1.0 / TICKS_PER_SECOND;
+
+TEST_CASE("[MainTimerSync] Deterministic steps ignore the wall clock") {
+	const bool delta_smoothing = OS::get_singleton()->is_delta_smoothing_enabled();
+	OS::get_singleton()->set_delta_smoothing(false);
+
+	MainTimerSync timer_sync;
+	uint64_t ticks = 1000;
+	timer_sync.init(ticks);
+	timer_sync.set_fixed_fps(-1);
+
+	SUBCASE("Each frame takes exactly the requested number of ticks") {
+		timer_sync.set_deterministic_steps(3);
+		const uint64_t wall_deltas[] = { 0, 100, 16667, 250000, 2000000 };
+		for (uint64_t delta : wall_deltas) {
+			ticks += delta;
+			timer_sync.set_cpu_ticks_usec(ticks);
+			MainFrameTime frame_time = timer_sync.advance(PHYSICS_STEP, TICKS_PER_SECOND);
+			CHECK_EQ(frame_time.physics_steps, 3);
+			CHECK_EQ(frame_time.process_step, doctest::Approx(3 * PHYSICS_STEP));
+			CHECK_EQ(frame_time.interpolation_fraction, 0.0);
+		}
+	}
+
+	SUBCASE("No queued ticks means no simulated time") {
+		// What an external clock that wasn't advanced during the frame asks for.
+		timer_sync.set_deterministic_steps(0);
+		ticks += 500000;
+		timer_sync.set_cpu_ticks_usec(ticks);
+		MainFrameTime frame_time = timer_sync.advance(PHYSICS_STEP, TICKS_PER_SECOND);
+		CHECK_EQ(frame_time.physics_steps, 0);
+		CHECK_EQ(frame_time.process_step, 0.0);
+	}
+
+	SUBCASE("Adaptive stepping resumes without catching up on skipped wall clock time") {
+		// Slow deterministic frames, one second of wall clock time each.
+		timer_sync.set_deterministic_steps(1);
+		for (int i = 0; i < 5; i++) {
+			ticks += 1000000;
+			timer_sync.set_cpu_ticks_usec(ticks);
+			timer_sync.advance(PHYSICS_STEP, TICKS_PER_SECOND);
+		}
+
+		timer_sync.set_deterministic_steps(-1);
+		int total_steps = 0;
+		for (int i = 0; i < TICKS_PER_SECOND; i++) {
+			ticks += 1000000 / TICKS_PER_SECOND;
+			timer_sync.set_cpu_ticks_usec(ticks);
+			MainFrameTime frame_time = timer_sync.advance(PHYSICS_STEP, TICKS_PER_SECOND);
+			CHECK_LE(frame_time.physics_steps, 2);
+			total_steps += frame_time.physics_steps;
+		}
+		CHECK_GE(total_steps, TICKS_PER_SECOND - 1);
+		CHECK_LE(total_steps, TICKS_PER_SECOND + 1);
+	}
+
+	OS::get_singleton()->set_delta_smoothing(delta_smoothing);
+}
+
+} // namespace TestMainTimerSync
+
+#endif // TEST_MAIN_TIMER_SYNC_H
@@ -0,0 +1,281 @@
+/**************************************************************************/
+/*  test_godot_deterministic_math_2d.h                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_DETERMINISTIC_MATH_2D_H
+#define TEST_GODOT_DETERMINISTIC_MATH_2D_H
+
+#include "servers/physics_2d/godot_deterministic_math_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotDeterministicMath2D {
+
+typedef GodotDeterministicMath2D DMath;
+
+// Number of doubles between two values, where +0 and -0 count as the same value.
+static uint64_t ulp_distance(double p_a, double p_b) {
+	if (Math::is_nan(p_a) || Math::is_nan(p_b)) {
+		return Math::is_nan(p_a) && Math::is_nan(p_b) ? 0 : UINT64_MAX;
+	}
+	if (p_a == p_b) {
+		return 0;
+	}
+
+	int64_t a;
+	int64_t b;
+	memcpy(&a, &p_a, sizeof(a));
+	memcpy(&b, &p_b, sizeof(b));
+	// Map negative values so that neighboring doubles are neighboring integers.
+	if (a < 0) {
+		a = INT64_MIN - a;
+	}
+	if (b < 0) {
+		b = INT64_MIN - b;
+	}
+	return a > b ? (uint64_t)a - (uint64_t)b : (uint64_t)b - (uint64_t)a;
+}
+
+static uint64_t bits(double p_value) {
+	uint64_t result;
+	memcpy(&result, &p_value, sizeof(result));
+	return result;
+}
+
+// Keeps the largest error seen against libm, and where it happened, so that a failure is reported once.
+struct MaxError {
+	uint64_t ulps = 0;
+	double at = 0.0;
+
+	void add(double p_at, double p_result, double p_expected) {
+		const uint64_t distance = ulp_distance(p_result, p_expected);
+		if (distance > ulps) {
+			ulps = distance;
+			at = p_at;
+		}
+	}
+};
+
+// Arguments around p_x, including p_x itself.
+static Vector<double> neighbors(double p_x, int p_count = 3) {
+	Vector<double> values;
+	values.push_back(p_x);
+	double below = p_x;
+	double above = p_x;
+	for (int i = 0; i < p_count; i++) {
+		below = ::nextafter(below, -INFINITY);
+		above = ::nextafter(above, INFINITY);
+		values.push_back(below);
+		values.push_back(above);
+	}
+	return values;
+}
+
+TEST_CASE("[GodotDeterministicMath2D] sin() and cos() are within an ulp of libm") {
+	MaxError sin_error;
+	MaxError cos_error;
+
+	for (int i = -200000; i <= 200000; i++) {
+		const double x = i * 0.0005;
+		sin_error.add(x, DMath::sin(x), Math::sin(x));
+		cos_error.add(x, DMath::cos(x), Math::cos(x));
+	}
+
+	// Multiples of pi/4 are where the reduced argument and the quadrant change.
+	for (int k = -64; k <= 64; k++) {
+		for (double x : neighbors(k * Math_PI * 0.25)) {
+			sin_error.add(x, DMath::sin(x), Math::sin(x));
+			cos_error.add(x, DMath::cos(x), Math::cos(x));
+		}
+	}
+
+	// Small arguments, down to the point where sin(x) rounds to x.
+	for (double x = 1.0; x > 1e-12; x *= 0.5) {
+		for (double v : neighbors(x, 1)) {
+			sin_error.add(v, DMath::sin(v), Math::sin(v));
+			sin_error.add(-v, DMath::sin(-v), Math::sin(-v));
+			cos_error.add(v, DMath::cos(v), Math::cos(v));
+		}
+	}
+
+	CHECK_MESSAGE(sin_error.ulps <= 1, vformat("sin() is off by %d ulps at %.17f.", sin_error.ulps, sin_error.at));
+	CHECK_MESSAGE(cos_error.ulps <= 1, vformat("cos() is off by %d ulps at %.17f.", cos_error.ulps, cos_error.at));
+
+	double s;
+	double c;
+	DMath::sin_cos(1.25, s, c);
+	CHECK(s == DMath::sin(1.25));
+	CHECK(c == DMath::cos(1.25));
+
+	CHECK(DMath::sin(0.0) == 0.0);
+	CHECK_FALSE(signbit(DMath::sin(0.0)));
+	CHECK(DMath::sin(-0.0) == 0.0);
+	CHECK(signbit(DMath::sin(-0.0)));
+	CHECK(DMath::cos(0.0) == 1.0);
+	CHECK(DMath::cos(-0.0) == 1.0);
+	CHECK(Math::is_nan(DMath::sin(INFINITY)));
+	CHECK(Math::is_nan(DMath::sin(-INFINITY)));
+	CHECK(Math::is_nan(DMath::cos(INFINITY)));
+	CHECK(Math::is_nan(DMath::sin(NAN)));
+	CHECK(Math::is_nan(DMath::cos(NAN)));
+}
+
+TEST_CASE("[GodotDeterministicMath2D] atan2() is within an ulp of libm") {
+	MaxError error;
+
+	for (double radius : { 1e-3, 1.0, 1e3 }) {
+		for (int i = 0; i < 4000; i++) {
+			const double angle = -Math_PI + i * (Math_PI / 2000.0);
+			const double y = radius * Math::sin(angle);
+			const double x = radius * Math::cos(angle);
+			error.add(angle, DMath::atan2(y, x), Math::atan2(y, x));
+		}
+	}
+
+	// Ratios around the points where atan() switches to a shifted argument, in every octant.
+	for (double ratio : { 7.0 / 16.0, 11.0 / 16.0, 1.0 }) {
+		for (double v : neighbors(ratio)) {
+			for (double sy : { 1.0, -1.0 }) {
+				for (double sx : { 1.0, -1.0 }) {
+					error.add(v, DMath::atan2(sy * v, sx), Math::atan2(sy * v, sx));
+					error.add(v, DMath::atan2(sx, sy * v), Math::atan2(sx, sy * v));
+				}
+			}
+		}
+	}
+
+	CHECK_MESSAGE(error.ulps <= 1, vformat("atan2() is off by %d ulps at %.17f.", error.ulps, error.at));
+
+	// Special values must match C exactly, including the sign of zero.
+	const double special[] = { 0.0, -0.0, 1.0, -1.0, INFINITY, -INFINITY, NAN };
+	for (double y : special) {
+		for (double x : special) {
+			const double result = DMath::atan2(y, x);
+			const double expected = Math::atan2(y, x);
+			CHECK_MESSAGE(ulp_distance(result, expected) == 0, vformat("atan2(%f, %f) returned %f instead of %f.", y, x, result, expected));
+			if (result == 0.0 && expected == 0.0) {
+				CHECK_MESSAGE(signbit(result) == signbit(expected), vformat("atan2(%f, %f) has the wrong sign.", y, x));
+			}
+		}
+	}
+}
+
+TEST_CASE("[GodotDeterministicMath2D] exp() is within an ulp of libm") {
+	MaxError error;
+
+	// Covers the whole range between underflow to zero and overflow to infinity.
+	for (int i = -149000; i <= 141956; i++) {
+		const double x = i * 0.005;
+		error.add(x, DMath::exp(x), Math::exp(x));
+	}
+
+	// Multiples of ln(2)/2 include the points where the power of two changes.
+	for (int k = -2149; k <= 2047; k++) {
+		for (double x : neighbors(k * Math_LN2 * 0.5, 1)) {
+			error.add(x, DMath::exp(x), Math::exp(x));
+		}
+	}
+
+	// Around the largest finite result and the smallest subnormal one.
+	for (double x : neighbors(709.782712893384)) {
+		error.add(x, DMath::exp(x), Math::exp(x));
+	}
+	for (double x : neighbors(-745.1332191019411)) {
+		error.add(x, DMath::exp(x), Math::exp(x));
+	}
+
+	CHECK_MESSAGE(error.ulps <= 1, vformat("exp() is off by %d ulps at %.17f.", error.ulps, error.at));
+
+	CHECK(DMath::exp(0.0) == 1.0);
+	CHECK(DMath::exp(-0.0) == 1.0);
+	CHECK(DMath::exp(INFINITY) == INFINITY);
+	CHECK(DMath::exp(-INFINITY) == 0.0);
+	CHECK(DMath::exp(1000.0) == INFINITY);
+	CHECK(DMath::exp(-1000.0) == 0.0);
+	CHECK(Math::is_nan(DMath::exp(NAN)));
+}
+
+TEST_CASE("[GodotDeterministicMath2D] Results have the same bits on every platform") {
+	// Expected bit patterns, so that a compiler or CPU that rounds differently is caught even where libm agrees with it.
+	struct Case {
+		double x;
+		uint64_t sin;
+		uint64_t cos;
+	};
+	const Case trig_cases[] = {
+		{ 0.5, 0x3fdeaee8744b05f0, 0x3fec1528065b7d50 },
+		{ 1.0, 0x3feaed548f090cee, 0x3fe14a280fb5068c },
+		{ 2.0, 0x3fed18f6ead1b446, 0xbfdaa22657537205 },
+		{ -3.0, 0xbfc210386db6d55b, 0xbfefae04be85e5d2 },
+		{ 10.0, 0xbfe1689ef5f34f53, 0xbfead9ac890c6b1f },
+		{ 100.0, 0xbfe03425b78c4db8, 0x3feb981dbf665fe0 },
+		{ 0.001, 0x3f50624da5218a62, 0x3feffffef390876c },
+	};
+	for (const Case &c : trig_cases) {
+		CHECK_MESSAGE(bits(DMath::sin(c.x)) == c.sin, vformat("sin(%f) has different bits.", c.x));
+		CHECK_MESSAGE(bits(DMath::cos(c.x)) == c.cos, vformat("cos(%f) has different bits.", c.x));
+	}
+
+	struct Atan2Case {
+		double y;
+		double x;
+		uint64_t atan2;
+	};
+	const Atan2Case atan2_cases[] = {
+		{ 1.0, 1.0, 0x3fe921fb54442d18 },
+		{ 1.0, -2.0, 0x40056c6e7397f5ae },
+		{ -3.0, 0.5, 0xbff67d8863bc99bd },
+		{ -0.25, -4.0, 0xc008a225e5677921 },
+		{ 2.0, 0.001, 0x3ff91fef0a8cabe5 },
+	};
+	for (const Atan2Case &c : atan2_cases) {
+		CHECK_MESSAGE(bits(DMath::atan2(c.y, c.x)) == c.atan2, vformat("atan2(%f, %f) has different bits.", c.y, c.x));
+	}
+
+	struct ExpCase {
+		double x;
+		uint64_t exp;
+	};
+	const ExpCase exp_cases[] = {
+		{ 1.0, 0x4005bf0a8b14576a },
+		{ -1.0, 0x3fd78b56362cef38 },
+		{ 0.5, 0x3ffa61298e1e069c },
+		{ -10.0, 0x3f07cd79b5647c9a },
+		{ 20.0, 0x41bceb088b68e804 },
+		{ -700.0, 0x00d14f2b0fb9307f },
+		{ 700.0, 0x7f0d945df4f8ec8e },
+	};
+	for (const ExpCase &c : exp_cases) {
+		CHECK_MESSAGE(bits(DMath::exp(c.x)) == c.exp, vformat("exp(%f) has different bits.", c.x));
+	}
+}
+
+} // namespace TestGodotDeterministicMath2D
+
+#endif // TEST_GODOT_DETERMINISTIC_MATH_2D_H
@@ -0,0 +1,70 @@
+/**************************************************************************/
+/*  physics_server_test_tools.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef PHYSICS_SERVER_TEST_TOOLS_H
+#define PHYSICS_SERVER_TEST_TOOLS_H
+
+#include "core/templates/rid.h"
+#include "core/templates/vector.h"
+
+#include "tests/test_macros.h"
+
+// Shared by the 2D and 3D physics server tests, which only differ in how they build the scene in p_space.
+// Steps the scene, saves a snapshot, and checks that stepping again from the restored snapshot gives a
+// byte for byte identical state.
+template <class T>
+void check_space_snapshot_resimulation(T *p_physics_server, RID p_space) {
+	const real_t step = 1.0 / 60.0;
+
+	// Let the scene settle, so that the same pairs exist when saving and when restoring.
+	for (int i = 0; i < 30; i++) {
+		p_physics_server->step(step);
+	}
+
+	const Vector<uint8_t> saved = p_physics_server->space_save_state(p_space);
+	REQUIRE_FALSE(saved.is_empty());
+
+	for (int i = 0; i < 30; i++) {
+		p_physics_server->step(step);
+	}
+	const Vector<uint8_t> simulated = p_physics_server->space_save_state(p_space);
+
+	CHECK(p_physics_server->space_restore_state(p_space, saved));
+	CHECK(p_physics_server->space_save_state(p_space) == saved);
+
+	for (int i = 0; i < 30; i++) {
+		p_physics_server->step(step);
+	}
+	const Vector<uint8_t> resimulated = p_physics_server->space_save_state(p_space);
+
+	CHECK_MESSAGE(resimulated == simulated, "Resimulating from a snapshot should give a byte for byte identical state.");
+}
+
+#endif // PHYSICS_SERVER_TEST_TOOLS_H
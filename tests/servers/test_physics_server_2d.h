@@ -0,0 +1,158 @@
+/**************************************************************************/
+/*  test_physics_server_2d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_2D_H
+#define TEST_PHYSICS_SERVER_2D_H
+
+#include "servers/physics_server_2d.h"
+
+#include "core/config/project_settings.h"
+#include "tests/servers/physics_server_test_tools.h"
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer2D {
+
+TEST_CASE("[SceneTree][PhysicsServer2D] Resimulating from a space snapshot gives the same result") {
+	PhysicsServer2D *physics_server = PhysicsServer2D::get_singleton();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	physics_server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY, 980);
+	physics_server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY_VECTOR, Vector2(0, 1));
+
+	RID floor_shape = physics_server->rectangle_shape_create();
+	physics_server->shape_set_data(floor_shape, Vector2(500, 20));
+	RID floor = physics_server->body_create();
+	physics_server->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(floor, floor_shape);
+	physics_server->body_set_space(floor, space);
+
+	// A stack is solved as a single island, so the result depends on the order its bodies are visited in.
+	RID box_shape = physics_server->rectangle_shape_create();
+	physics_server->shape_set_data(box_shape, Vector2(20, 20));
+	LocalVector<RID> boxes;
+	for (int i = 0; i < 4; i++) {
+		RID box = physics_server->body_create();
+		physics_server->body_set_mode(box, PhysicsServer2D::BODY_MODE_RIGID);
+		physics_server->body_add_shape(box, box_shape);
+		physics_server->body_set_space(box, space);
+		physics_server->body_set_state(box, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(2 * i, -40.5 - 40.5 * i)));
+		boxes.push_back(box);
+	}
+
+	check_space_snapshot_resimulation(physics_server, space);
+
+	for (const RID &box : boxes) {
+		physics_server->free(box);
+	}
+	physics_server->free(box_shape);
+	physics_server->free(floor);
+	physics_server->free(floor_shape);
+	physics_server->free(space);
+}
+
+// Simulates spinning boxes falling on a floor, two of them tied by a damped spring, and returns the final
+// transform and velocities of every box. The deterministic setting is read when the space is created.
+LocalVector<real_t> simulate_spinning_boxes(int p_steps) {
+	PhysicsServer2D *physics_server = PhysicsServer2D::get_singleton();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	physics_server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY, 980);
+	physics_server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY_VECTOR, Vector2(0, 1));
+
+	RID floor_shape = physics_server->rectangle_shape_create();
+	physics_server->shape_set_data(floor_shape, Vector2(500, 20));
+	RID floor = physics_server->body_create();
+	physics_server->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(floor, floor_shape);
+	physics_server->body_set_space(floor, space);
+
+	RID box_shape = physics_server->rectangle_shape_create();
+	physics_server->shape_set_data(box_shape, Vector2(10, 10));
+	LocalVector<RID> boxes;
+	for (int i = 0; i < 8; i++) {
+		RID box = physics_server->body_create();
+		physics_server->body_set_mode(box, PhysicsServer2D::BODY_MODE_RIGID);
+		physics_server->body_add_shape(box, box_shape);
+		physics_server->body_set_space(box, space);
+		physics_server->body_set_state(box, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0.3 * i, Vector2(25 * i - 100, -60 - 15 * i)));
+		physics_server->body_set_state(box, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY, 2.0 - 0.5 * i);
+		boxes.push_back(box);
+	}
+
+	RID spring = physics_server->joint_create();
+	physics_server->joint_make_damped_spring(spring, Vector2(-75, -75), Vector2(-50, -90), boxes[1], boxes[2]);
+	physics_server->damped_spring_joint_set_param(spring, PhysicsServer2D::DAMPED_SPRING_STIFFNESS, 40);
+	physics_server->damped_spring_joint_set_param(spring, PhysicsServer2D::DAMPED_SPRING_DAMPING, 0.5);
+
+	for (int i = 0; i < p_steps; i++) {
+		physics_server->step(1.0 / 60.0);
+	}
+
+	LocalVector<real_t> states;
+	for (const RID &box : boxes) {
+		const Transform2D transform = physics_server->body_get_state(box, PhysicsServer2D::BODY_STATE_TRANSFORM);
+		const Vector2 linear_velocity = physics_server->body_get_state(box, PhysicsServer2D::BODY_STATE_LINEAR_VELOCITY);
+		for (int i = 0; i < 3; i++) {
+			states.push_back(transform.columns[i].x);
+			states.push_back(transform.columns[i].y);
+		}
+		states.push_back(linear_velocity.x);
+		states.push_back(linear_velocity.y);
+		states.push_back(physics_server->body_get_state(box, PhysicsServer2D::BODY_STATE_ANGULAR_VELOCITY));
+	}
+
+	physics_server->free(spring);
+	for (const RID &box : boxes) {
+		physics_server->free(box);
+	}
+	physics_server->free(box_shape);
+	physics_server->free(floor);
+	physics_server->free(floor_shape);
+	physics_server->free(space);
+	return states;
+}
+
+TEST_CASE("[SceneTree][PhysicsServer2D] A deterministic simulation gives bit-identical results when run twice") {
+	ProjectSettings *project_settings = ProjectSettings::get_singleton();
+
+	project_settings->set_setting("physics/2d/deterministic_simulation", true);
+	const LocalVector<real_t> first = simulate_spinning_boxes(120);
+	const LocalVector<real_t> second = simulate_spinning_boxes(120);
+	project_settings->set_setting("physics/2d/deterministic_simulation", false);
+
+	REQUIRE(first.size() == second.size());
+	CHECK_MESSAGE(memcmp(first.ptr(), second.ptr(), first.size() * sizeof(real_t)) == 0, "Both runs should end with bit-identical body states.");
+}
+
+} // namespace TestPhysicsServer2D
+
+#endif // TEST_PHYSICS_SERVER_2D_H
@@ -0,0 +1,600 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "servers/physics_server_3d.h"
+
+#include "core/config/project_settings.h"
+#include "core/math/bvh.h"
+#include "core/math/random_pcg.h"
+#include "core/object/worker_thread_pool.h"
+#include "servers/physics_3d/godot_physics_server_3d.h"
+#include "servers/physics_server_3d_wrap_mt.h"
+#include "tests/servers/physics_server_test_tools.h"
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer3D {
+
+struct PairingItem {
+	uint32_t index = 0;
+};
+
+class PairingItemTest {
+public:
+	static bool user_pair_check(const PairingItem *p_a, const PairingItem *p_b) {
+		return true;
+	}
+	static bool user_cull_check(const PairingItem *p_a, const PairingItem *p_b) {
+		return true;
+	}
+};
+
+// Records the pair and unpair callbacks of a tree set up like the 3D broadphase.
+struct PairingRecorder {
+	BVH_Manager<PairingItem, 2, true, 128, PairingItemTest, PairingItemTest> bvh;
+	LocalVector<Vector3i> events; // Pair (1) or unpair (0), then both item indices.
+
+	static void *_pair(void *p_self, uint32_t p_id_a, PairingItem *p_a, int p_subindex_a, uint32_t p_id_b, PairingItem *p_b, int p_subindex_b) {
+		static_cast<PairingRecorder *>(p_self)->events.push_back(Vector3i(1, p_a->index, p_b->index));
+		return nullptr;
+	}
+
+	static void _unpair(void *p_self, uint32_t p_id_a, PairingItem *p_a, int p_subindex_a, uint32_t p_id_b, PairingItem *p_b, int p_subindex_b, void *p_pair_data) {
+		static_cast<PairingRecorder *>(p_self)->events.push_back(Vector3i(0, p_a->index, p_b->index));
+	}
+
+	static void _parallel_for(void *p_self, void (*p_func)(void *, uint32_t), void *p_func_userdata, uint32_t p_count) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(p_func, p_func_userdata, p_count, -1, true, SNAME("TestBroadphasePairing"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
+	PairingRecorder(bool p_parallel) {
+		bvh.set_pair_callback(_pair, this);
+		bvh.set_unpair_callback(_unpair, this);
+		if (p_parallel) {
+			bvh.set_parallel_pairing_callback(_parallel_for, this, 1);
+		}
+	}
+};
+
+TEST_CASE("[PhysicsServer3D] Broadphase pairs found on worker threads match the serial ones") {
+	const uint32_t item_count = 600;
+	LocalVector<PairingItem> items;
+	items.resize(item_count);
+
+	PairingRecorder serial(false);
+	PairingRecorder parallel(true);
+	LocalVector<BVHHandle> serial_handles;
+	LocalVector<BVHHandle> parallel_handles;
+
+	RandomPCG rng(1234);
+	for (uint32_t i = 0; i < item_count; i++) {
+		items[i].index = i;
+		// Static items don't pair with each other, like in the broadphase.
+		const bool is_static = i % 4 == 0;
+		const uint32_t tree_id = is_static ? 0 : 1;
+		const uint32_t tree_collision_mask = is_static ? 2 : 3;
+		const AABB aabb(Vector3(rng.randf(), rng.randf(), rng.randf()) * 20, Vector3(1, 1, 1));
+		serial_handles.push_back(serial.bvh.create(&items[i], true, tree_id, tree_collision_mask, aabb));
+		parallel_handles.push_back(parallel.bvh.create(&items[i], true, tree_id, tree_collision_mask, aabb));
+	}
+	serial.bvh.update();
+	parallel.bvh.update();
+	REQUIRE_FALSE(serial.events.is_empty());
+
+	// Move the dynamic items around so that pairs are also removed.
+	for (int step = 0; step < 5; step++) {
+		for (uint32_t i = 0; i < item_count; i++) {
+			if (i % 4 == 0) {
+				continue;
+			}
+			const AABB aabb(Vector3(rng.randf(), rng.randf(), rng.randf()) * 20, Vector3(1, 1, 1));
+			serial.bvh.move(serial_handles[i], aabb);
+			parallel.bvh.move(parallel_handles[i], aabb);
+		}
+		serial.bvh.update();
+		parallel.bvh.update();
+	}
+
+	CHECK_MESSAGE(parallel.events.size() == serial.events.size(), "The same number of pair callbacks should be sent.");
+	bool same_order = parallel.events.size() == serial.events.size();
+	for (uint32_t i = 0; same_order && i < serial.events.size(); i++) {
+		same_order = parallel.events[i] == serial.events[i];
+	}
+	CHECK_MESSAGE(same_order, "The pair callbacks should be sent in the same order.");
+
+	for (uint32_t i = 0; i < item_count; i++) {
+		serial.bvh.erase(serial_handles[i]);
+		parallel.bvh.erase(parallel_handles[i]);
+	}
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Resimulating from a space snapshot gives the same result") {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	physics_server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY, 9.8);
+	physics_server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY_VECTOR, Vector3(0, -1, 0));
+
+	RID floor_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(floor_shape, Vector3(10, 0.5, 10));
+	RID floor = physics_server->body_create();
+	physics_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(floor, floor_shape);
+	physics_server->body_set_space(floor, space);
+
+	// A stack is solved as a single island, so the result depends on the order its bodies are visited in.
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	LocalVector<RID> boxes;
+	for (int i = 0; i < 4; i++) {
+		RID box = physics_server->body_create();
+		physics_server->body_set_mode(box, PhysicsServer3D::BODY_MODE_RIGID);
+		physics_server->body_add_shape(box, box_shape);
+		physics_server->body_set_space(box, space);
+		physics_server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0.05 * i, 1.01 + 1.01 * i, 0)));
+		boxes.push_back(box);
+	}
+
+	check_space_snapshot_resimulation(physics_server, space);
+
+	for (const RID &box : boxes) {
+		physics_server->free(box);
+	}
+	physics_server->free(box_shape);
+	physics_server->free(floor);
+	physics_server->free(floor_shape);
+	physics_server->free(space);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Continuous collision detection doesn't push a resting body hit by a fast one") {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	physics_server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY, 0);
+
+	RID sphere_shape = physics_server->sphere_shape_create();
+	physics_server->shape_set_data(sphere_shape, 0.5);
+
+	RID resting = physics_server->body_create();
+	physics_server->body_set_mode(resting, PhysicsServer3D::BODY_MODE_RIGID);
+	physics_server->body_add_shape(resting, sphere_shape);
+	physics_server->body_set_space(resting, space);
+	physics_server->body_set_enable_continuous_collision_detection(resting, true);
+
+	// Reaches the resting body halfway through the first step.
+	RID fast = physics_server->body_create();
+	physics_server->body_set_mode(fast, PhysicsServer3D::BODY_MODE_RIGID);
+	physics_server->body_add_shape(fast, sphere_shape);
+	physics_server->body_set_space(fast, space);
+	physics_server->body_set_enable_continuous_collision_detection(fast, true);
+	physics_server->body_set_state(fast, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(-3, 0, 0)));
+	physics_server->body_set_state(fast, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(240, 0, 0));
+
+	physics_server->step(1.0 / 60.0);
+
+	const Vector3 resting_velocity = physics_server->body_get_state(resting, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+	const Vector3 fast_velocity = physics_server->body_get_state(fast, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+	CHECK_MESSAGE(resting_velocity.is_zero_approx(), "The resting body shouldn't move before it is hit.");
+	CHECK_MESSAGE(fast_velocity.x < 240, "The fast body should be slowed down instead.");
+	CHECK_MESSAGE((resting_velocity + fast_velocity).length() <= 240, "Continuous collision detection shouldn't add momentum.");
+
+	physics_server->free(fast);
+	physics_server->free(resting);
+	physics_server->free(sphere_shape);
+	physics_server->free(space);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Batched ray casts match single ray casts") {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	LocalVector<RID> boxes;
+	RandomPCG rng(42);
+	for (int i = 0; i < 100; i++) {
+		RID box = physics_server->body_create();
+		physics_server->body_set_mode(box, PhysicsServer3D::BODY_MODE_STATIC);
+		physics_server->body_add_shape(box, box_shape);
+		physics_server->body_set_space(box, space);
+		physics_server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(rng.randf() * 20, rng.randf() * 5, rng.randf() * 20)));
+		boxes.push_back(box);
+	}
+
+	// Enough rays for the batch to be split across the worker threads, some of which miss.
+	const int ray_count = 256;
+	LocalVector<Vector3> from;
+	LocalVector<Vector3> to;
+	for (int i = 0; i < ray_count; i++) {
+		const Vector3 origin(rng.randf() * 20, 10, rng.randf() * 20);
+		from.push_back(origin);
+		to.push_back(origin + Vector3(rng.randf() - 0.5, -20, rng.randf() - 0.5));
+	}
+
+	PhysicsDirectSpaceState3D *space_state = physics_server->space_get_direct_state(space);
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+	results.resize(ray_count);
+	LocalVector<bool> hits;
+	hits.resize(ray_count);
+	space_state->intersect_rays(parameters, from.ptr(), to.ptr(), ray_count, results.ptr(), hits.ptr());
+
+	int hit_count = 0;
+	int mismatch_count = 0;
+	for (int i = 0; i < ray_count; i++) {
+		parameters.from = from[i];
+		parameters.to = to[i];
+		PhysicsDirectSpaceState3D::RayResult result;
+		const bool hit = space_state->intersect_ray(parameters, result);
+		hit_count += hit;
+		if (hit != hits[i]) {
+			mismatch_count++;
+		} else if (hit && (result.rid != results[i].rid || result.position != results[i].position || result.normal != results[i].normal || result.shape != results[i].shape)) {
+			mismatch_count++;
+		}
+	}
+	CHECK_MESSAGE(hit_count > 0, "Some rays should hit the boxes.");
+	CHECK_MESSAGE(hit_count < ray_count, "Some rays should miss the boxes.");
+	CHECK_MESSAGE(mismatch_count == 0, "Each batched ray should give the same result as casting it alone.");
+
+	for (const RID &box : boxes) {
+		physics_server->free(box);
+	}
+	physics_server->free(box_shape);
+	physics_server->free(space);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Consecutive motion tests see the changes made between them") {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	RID character = physics_server->body_create();
+	physics_server->body_set_mode(character, PhysicsServer3D::BODY_MODE_KINEMATIC);
+	physics_server->body_add_shape(character, box_shape);
+	physics_server->body_set_space(character, space);
+
+	PhysicsServer3D::MotionParameters parameters(Transform3D(), Vector3(10, 0, 0));
+	PhysicsServer3D::MotionResult result;
+	CHECK_FALSE(physics_server->body_test_motion(character, parameters, &result));
+
+	RID wall_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(wall_shape, Vector3(0.5, 2, 2));
+	RID wall = physics_server->body_create();
+	physics_server->body_set_mode(wall, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(wall, wall_shape);
+	physics_server->body_set_state(wall, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(5, 0, 0)));
+	physics_server->body_set_space(wall, space);
+	CHECK_MESSAGE(physics_server->body_test_motion(character, parameters, &result), "A body added after the last test should be hit.");
+	CHECK(result.travel.x < 4);
+
+	// Moving along the previous motion, as move_and_slide() does, within the region culled before.
+	parameters.from.origin = result.travel;
+	parameters.motion = Vector3(0, 0, 1);
+	CHECK_FALSE(physics_server->body_test_motion(character, parameters, &result));
+	parameters.motion = Vector3(1, 0, 0);
+	CHECK(physics_server->body_test_motion(character, parameters, &result));
+
+	physics_server->body_set_state(wall, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(-5, 0, 0)));
+	CHECK_FALSE_MESSAGE(physics_server->body_test_motion(character, parameters, &result), "A body moved away since the last test shouldn't be hit.");
+
+	physics_server->body_set_state(wall, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(5, 0, 0)));
+	parameters.exclude_bodies.insert(wall);
+	CHECK_FALSE(physics_server->body_test_motion(character, parameters, &result));
+	parameters.exclude_bodies.clear();
+	CHECK(physics_server->body_test_motion(character, parameters, &result));
+
+	physics_server->free(wall);
+	CHECK_FALSE_MESSAGE(physics_server->body_test_motion(character, parameters, &result), "A body freed since the last test shouldn't be hit.");
+
+	physics_server->free(wall_shape);
+	physics_server->free(character);
+	physics_server->free(box_shape);
+	physics_server->free(space);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Motion tests find obstacles when the broadphase results are full") {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	RID character = physics_server->body_create();
+	physics_server->body_set_mode(character, PhysicsServer3D::BODY_MODE_KINEMATIC);
+	physics_server->body_add_shape(character, box_shape);
+	physics_server->body_set_space(character, space);
+
+	// More shapes than a single query returns, near the motion but out of its way.
+	RID clutter_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(clutter_shape, Vector3(0.1, 0.1, 0.1));
+	RID clutter = physics_server->body_create();
+	physics_server->body_set_mode(clutter, PhysicsServer3D::BODY_MODE_STATIC);
+	RandomPCG rng(7);
+	for (int i = 0; i < 2500; i++) {
+		physics_server->body_add_shape(clutter, clutter_shape, Transform3D(Basis(), Vector3(rng.randf() * 20 - 5, 3 + rng.randf() * 5, rng.randf() * 20 - 10)));
+	}
+	physics_server->body_set_space(clutter, space);
+
+	RID wall_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(wall_shape, Vector3(0.5, 2, 2));
+	RID wall = physics_server->body_create();
+	physics_server->body_set_mode(wall, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(wall, wall_shape);
+	physics_server->body_set_state(wall, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(5, 0, 0)));
+	physics_server->body_set_space(wall, space);
+
+	PhysicsServer3D::MotionParameters parameters(Transform3D(), Vector3(10, 0, 0));
+	PhysicsServer3D::MotionResult result;
+	CHECK_MESSAGE(physics_server->body_test_motion(character, parameters, &result), "The wall should be hit even if the cull around the motion is full.");
+	CHECK(result.travel.x < 4);
+
+	physics_server->free(wall);
+	physics_server->free(wall_shape);
+	physics_server->free(clutter);
+	physics_server->free(clutter_shape);
+	physics_server->free(character);
+	physics_server->free(box_shape);
+	physics_server->free(space);
+}
+
+// Steps a grid of touching boxes resting on a floor, which forms a single island of over 512 constraints,
+// and returns the final transforms of the boxes. The solver settings are read when the space is created.
+LocalVector<Transform3D> simulate_box_grid(int p_steps) {
+	PhysicsServer3D *physics_server = PhysicsServer3D::get_singleton();
+	const int grid_size = 16;
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	physics_server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY, 9.8);
+	physics_server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY_VECTOR, Vector3(0, -1, 0));
+
+	RID floor_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(floor_shape, Vector3(20, 0.5, 20));
+	RID floor = physics_server->body_create();
+	physics_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(floor, floor_shape);
+	physics_server->body_set_space(floor, space);
+
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	LocalVector<RID> boxes;
+	for (int i = 0; i < grid_size * grid_size; i++) {
+		RID box = physics_server->body_create();
+		physics_server->body_set_mode(box, PhysicsServer3D::BODY_MODE_RIGID);
+		physics_server->body_add_shape(box, box_shape);
+		physics_server->body_set_space(box, space);
+		const Vector3 origin((i % grid_size) * 0.999 - grid_size * 0.5, 1.0, (i / grid_size) * 0.999 - grid_size * 0.5);
+		physics_server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), origin));
+		boxes.push_back(box);
+	}
+
+	for (int i = 0; i < p_steps; i++) {
+		physics_server->step(1.0 / 60.0);
+	}
+
+	LocalVector<Transform3D> transforms;
+	for (const RID &box : boxes) {
+		transforms.push_back(physics_server->body_get_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM));
+		physics_server->free(box);
+	}
+	physics_server->free(box_shape);
+	physics_server->free(floor);
+	physics_server->free(floor_shape);
+	physics_server->free(space);
+	return transforms;
+}
+
+// Solving order differs between the compared paths, so the results are only expected to be close.
+void check_transforms_close(const LocalVector<Transform3D> &p_a, const LocalVector<Transform3D> &p_b, real_t p_tolerance) {
+	REQUIRE(p_a.size() == p_b.size());
+	real_t max_distance = 0;
+	for (uint32_t i = 0; i < p_a.size(); i++) {
+		max_distance = MAX(max_distance, p_a[i].origin.distance_to(p_b[i].origin));
+	}
+	CHECK_MESSAGE(max_distance < p_tolerance, vformat("Bodies ended up to %f apart.", max_distance));
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] A large island solved in parallel batches matches solving it serially") {
+	ProjectSettings *project_settings = ProjectSettings::get_singleton();
+
+	project_settings->set_setting("physics/3d/solver/split_large_islands", false);
+	const LocalVector<Transform3D> serial = simulate_box_grid(30);
+	project_settings->set_setting("physics/3d/solver/split_large_islands", true);
+	const LocalVector<Transform3D> batched = simulate_box_grid(30);
+
+	check_transforms_close(serial, batched, 0.01);
+	for (const Transform3D &transform : batched) {
+		CHECK_MESSAGE(transform.origin.y > 0.9, "Boxes shouldn't sink into the floor.");
+	}
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Contacts solved in packs match contacts solved one pair at a time") {
+	ProjectSettings *project_settings = ProjectSettings::get_singleton();
+
+	// Both split the island into the same batches, only the contact solver differs.
+	project_settings->set_setting("physics/3d/solver/packed_contact_solver", false);
+	const LocalVector<Transform3D> pairs = simulate_box_grid(30);
+	project_settings->set_setting("physics/3d/solver/packed_contact_solver", true);
+	const LocalVector<Transform3D> packed = simulate_box_grid(30);
+	project_settings->set_setting("physics/3d/solver/packed_contact_solver", false);
+
+	check_transforms_close(pairs, packed, 0.001);
+}
+
+static PhysicsServer3D *create_threaded_server() {
+	PhysicsServer3D *server = memnew(PhysicsServer3DWrapMT(memnew(GodotPhysicsServer3D(true)), true));
+	server->init();
+	server->set_active(true);
+	// The first sync doesn't wait for a step, so do it before any step is queued.
+	server->sync();
+	server->end_sync();
+	return server;
+}
+
+static void step_threaded_server(PhysicsServer3D *p_server) {
+	p_server->step(1.0 / 60.0);
+	p_server->sync();
+	p_server->flush_queries();
+	p_server->end_sync();
+}
+
+static void free_threaded_server(PhysicsServer3D *p_server) {
+	p_server->finish();
+	memdelete(p_server);
+}
+
+static RID create_floating_body(PhysicsServer3D *p_server, RID p_space, const Vector3 &p_origin) {
+	RID body = p_server->body_create();
+	p_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+	p_server->body_set_param(body, PhysicsServer3D::BODY_PARAM_GRAVITY_SCALE, 0.0);
+	p_server->body_set_param(body, PhysicsServer3D::BODY_PARAM_LINEAR_DAMP_MODE, PhysicsServer3D::BODY_DAMP_MODE_REPLACE);
+	p_server->body_set_param(body, PhysicsServer3D::BODY_PARAM_LINEAR_DAMP, 0.0);
+	p_server->body_set_state(body, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+	p_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), p_origin));
+	p_server->body_set_space(body, p_space);
+	return body;
+}
+
+TEST_CASE("[PhysicsServer3D] Body states read from the threaded server reflect the commands sent before") {
+	PhysicsServer3D *server = create_threaded_server();
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+	RID body = create_floating_body(server, space, Vector3(1, 2, 3));
+
+	// Start caching the body's state, and let a step fill the cache.
+	server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+	step_threaded_server(server);
+	Transform3D transform = server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+	CHECK(transform.origin.is_equal_approx(Vector3(1, 2, 3)));
+
+	server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(4, 5, 6)));
+	transform = server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+	CHECK_MESSAGE(transform.origin.is_equal_approx(Vector3(4, 5, 6)), "A read right after a write should return the written state.");
+
+	step_threaded_server(server);
+	transform = server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+	CHECK_MESSAGE(transform.origin.is_equal_approx(Vector3(4, 5, 6)), "A read after the next step should return the written state.");
+
+	server->body_apply_central_impulse(body, Vector3(2, 0, 0));
+	Vector3 linear_velocity = server->body_get_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+	CHECK_MESSAGE(linear_velocity.is_equal_approx(Vector3(2, 0, 0)), "A read right after an impulse should return the new velocity.");
+
+	step_threaded_server(server);
+	transform = server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+	CHECK(transform.origin.is_equal_approx(Vector3(4 + 2.0 / 60.0, 5, 6)));
+
+	server->free(body);
+	server->free(space);
+	free_threaded_server(server);
+}
+
+TEST_CASE("[PhysicsServer3D] Body states can't be read from the threaded server after the body is freed") {
+	PhysicsServer3D *server = create_threaded_server();
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+	RID body = create_floating_body(server, space, Vector3(1, 2, 3));
+
+	server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+	step_threaded_server(server);
+	Variant transform = server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+	CHECK(transform.get_type() == Variant::TRANSFORM3D);
+
+	server->free(body);
+
+	ERR_PRINT_OFF;
+	transform = server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(transform.get_type() == Variant::NIL, "A read after the body is freed shouldn't return its old state.");
+
+	step_threaded_server(server);
+
+	ERR_PRINT_OFF;
+	transform = server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+	ERR_PRINT_ON;
+	CHECK(transform.get_type() == Variant::NIL);
+
+	server->free(space);
+	free_threaded_server(server);
+}
+
+TEST_CASE("[PhysicsServer3D] Setting the state of many bodies at once sets each body's state") {
+	PhysicsServer3D *server = create_threaded_server();
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	Vector<RID> bodies;
+	Vector<Variant> values;
+	for (int i = 0; i < 4; i++) {
+		RID body = create_floating_body(server, space, Vector3(i * 2, 0, 0));
+		server->body_get_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+		bodies.push_back(body);
+		values.push_back(Vector3(0, i + 1, 0));
+	}
+	step_threaded_server(server);
+
+	server->bodies_set_state(bodies, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, values);
+	for (int i = 0; i < bodies.size(); i++) {
+		Vector3 linear_velocity = server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+		CHECK(linear_velocity.is_equal_approx(values[i]));
+	}
+
+	step_threaded_server(server);
+	for (int i = 0; i < bodies.size(); i++) {
+		Vector3 linear_velocity = server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+		CHECK(linear_velocity.is_equal_approx(values[i]));
+		Transform3D transform = server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK(transform.origin.is_equal_approx(Vector3(i * 2, (i + 1) / 60.0, 0)));
+	}
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+	server->free(space);
+	free_threaded_server(server);
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H